@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * Timing and allocation statistics of a single microbenchmark. All per
+ * operation values are medians over the measured samples.
+ */
+struct MicrobenchmarkResult {
+  std::string name;
+  size_t iterations;  // operations per sample
+  double ns_per_op;
+  double ops_per_second;
+  double allocations_per_op;
+};
+
+/**
+ * @return The number of heap allocations made so far by this process. Only
+ * the rubiks_cube_bench executable counts them, since it replaces the global
+ * operator new.
+ */
+size_t getAllocationCount();
+
+/**
+ * Forces value to be computed without the compiler being able to see how it
+ * is used, so that the benchmarked work cannot be optimized away.
+ */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief Measures operation, which performs a single benchmarked operation
+ * per call.
+ *
+ * A first untimed call builds any lazily generated tables, which would
+ * otherwise make a single iteration seem long enough. The iteration count is
+ * then doubled until a sample takes at least MinDuration, which also warms up
+ * caches. The median of Samples runs of that many iterations is then reported
+ * so that the results are stable between invocations.
+ */
+template <typename Operation>
+MicrobenchmarkResult measure(const std::string& name, Operation&& operation) {
+  static constexpr auto MinDuration = std::chrono::milliseconds{20};
+  static constexpr size_t Samples = 5;
+
+  const auto run = [&](const size_t& iterations) {
+    const auto t_start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) operation();
+    return std::chrono::steady_clock::now() - t_start;
+  };
+
+  operation();
+  size_t iterations = 1;
+  while (run(iterations) < MinDuration) iterations *= 2;
+
+  std::array<double, Samples> ns_per_op{};
+  std::array<size_t, Samples> allocations{};
+  for (size_t i = 0; i < Samples; ++i) {
+    const size_t allocations_before = getAllocationCount();
+    const std::chrono::duration<double, std::nano> ns = run(iterations);
+    allocations[i] = getAllocationCount() - allocations_before;
+    ns_per_op[i] = ns.count() / static_cast<double>(iterations);
+  }
+  std::sort(ns_per_op.begin(), ns_per_op.end());
+  std::sort(allocations.begin(), allocations.end());
+
+  const double median_ns = ns_per_op[Samples / 2];
+  return {name, iterations, median_ns, 1e9 / median_ns,
+          static_cast<double>(allocations[Samples / 2]) /
+              static_cast<double>(iterations)};
+}
+
+/**
+ * A value that is only computed, by make, the first time it is accessed. This
+ * lets a group of microbenchmarks share inputs that are only generated if one
+ * of them runs.
+ */
+template <typename T>
+class Lazy {
+ public:
+  template <typename Make>
+  explicit Lazy(Make&& make) : make(std::forward<Make>(make)) {}
+
+  const T& operator*() {
+    if (!value) value.emplace(make());
+    return *value;
+  }
+
+  const T* operator->() { return &**this; }
+
+ private:
+  std::function<T()> make;
+  std::optional<T> value;
+};
+
+template <typename Make>
+Lazy(Make) -> Lazy<std::invoke_result_t<Make>>;
+
+/**
+ * Collects the results of the microbenchmarks whose names contain a filter.
+ */
+class MicrobenchmarkSuite {
+ public:
+  explicit MicrobenchmarkSuite(std::string filter)
+      : filter(std::move(filter)) {}
+
+  /**
+   * @brief Measures the operation returned by make_operation if name contains
+   * the filter. make_operation is not called otherwise, so any inputs that it
+   * needs are only generated for the microbenchmarks that run.
+   */
+  template <typename MakeOperation>
+  void add(const std::string& name, MakeOperation&& make_operation) {
+    if (name.find(filter) != std::string::npos)
+      results.push_back(measure(name, make_operation()));
+  }
+
+  [[nodiscard]] const std::vector<MicrobenchmarkResult>& getResults() const {
+    return results;
+  }
+
+ private:
+  const std::string filter;
+  std::vector<MicrobenchmarkResult> results;
+};
+
+/**
+ * Prints one aligned line per result.
+ */
+void printResults(std::ostream& os,
+                  const std::vector<MicrobenchmarkResult>& results);
+
+/**
+ * Writes the results as a JSON object of the form
+ * {"benchmarks": [{"name": ..., "iterations": ..., "ns_per_op": ...,
+ * "ops_per_second": ..., "allocations_per_op": ...}, ...]}.
+ */
+void writeJson(std::ostream& os,
+               const std::vector<MicrobenchmarkResult>& results);
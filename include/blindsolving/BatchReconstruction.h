@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <thread>
+
+namespace blindsolving {
+struct BatchStatistics {
+  size_t attempt_count;
+  size_t failure_count;
+  double seconds;
+};
+
+/**
+ * Reconstructs every attempt read from input with utility::readScrambleSolve
+ * on thread_count threads. One line is written to output per attempt, in the
+ * order that they were read, as soon as it and every earlier attempt are done:
+ * "<index>\t<edit distance>\t<attempt>\t<closest reconstruction>" on success
+ * or "<index>\terror\t<message>" if the attempt could not be reconstructed.
+ * @param max_pending The most attempts that are read but not yet written at
+ * once, which bounds the memory used regardless of the size of input.
+ */
+BatchStatistics reconstructBatch(
+    std::istream& input, std::ostream& output,
+    const size_t& thread_count = std::thread::hardware_concurrency(),
+    const size_t& max_pending = 1024);
+}  // namespace blindsolving
@@ -7,7 +7,11 @@
 #include "EdgeLocation.h"
 #include "Reconstruction.h"
 #include "ReconstructionIterator.h"
+#include <cstddef>
+#include <thread>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace blindsolving {
 extern const std::unordered_map<char, Algorithm> EDGE_ALGS;
@@ -28,9 +32,34 @@ ReconstructionIterator getReconstructionIterator(Cube cube);
  * @param n The maximum number of BlindsolvingReconstructions to include in the
  * result.
  * @return A vector of the best BlindsolvingReconstructions for the given solve
- * and their corresponding Levenshtein distances.
+ * and their corresponding Levenshtein distances, from closest to furthest.
+ * Reconstructions with equal distances are in the order that it visits them.
  */
 std::vector<std::pair<BlindsolvingReconstruction, size_t>>
 getBestReconstructions(const Reconstruction& solve, ReconstructionIterator& it,
                        const size_t& max);
+
+/**
+ * Equivalent to getBestReconstructions, but splits the period of it into
+ * thread_count contiguous ranges that are scored on separate threads, each
+ * keeping its own best max reconstructions. Since ties are broken by the
+ * position in it, the merged result does not depend on thread_count.
+ */
+std::vector<std::pair<BlindsolvingReconstruction, size_t>>
+getBestReconstructionsParallel(
+    const Reconstruction& solve, const ReconstructionIterator& it,
+    const size_t& max,
+    const size_t& thread_count = std::thread::hardware_concurrency());
+
+/**
+ * Equivalent to getBestReconstructions, but builds the reconstructions cycle
+ * by cycle and skips every reconstruction whose prefix is already too far
+ * from the solve to be among the best, which is orders of magnitude faster
+ * for scrambles with many cycles.
+ */
+std::vector<std::pair<BlindsolvingReconstruction, size_t>>
+searchBestReconstructions(const Reconstruction& solve,
+                          const ReconstructionIterator& it, const size_t& max);
+
+void runBlindsolvingTests();
 }  // namespace blindsolving
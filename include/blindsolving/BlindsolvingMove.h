@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Cube.h"
+#include <cstdint>
 #include <string>
 
 namespace blindsolving {
@@ -28,6 +29,24 @@ struct BlindsolvingMove {
 
   constexpr ~BlindsolvingMove(){};
 };
+
+/**
+ * The number of symbols that encode maps BlindsolvingMoves to.
+ */
+constexpr uint8_t BlindsolvingMoveAlphabetSize = 55;
+
+/**
+ * Maps each BlindsolvingMove to a symbol in [0, BlindsolvingMoveAlphabetSize)
+ * such that two moves are equal if and only if their symbols are. Algs other
+ * than the letters A to Z (such as the sentinel for unparsed moves) share a
+ * symbol.
+ */
+constexpr uint8_t encode(const BlindsolvingMove& move) {
+  if (move.is_parity) return 0;
+  const uint8_t letter =
+      move.alg >= 'A' && move.alg <= 'Z' ? move.alg - 'A' + 1 : 0;
+  return move.is_edge ? letter + 1 : letter + 28;
+}
 }  // namespace blindsolving
 
 namespace std {
@@ -5,6 +5,8 @@
 #include "Lettering.h"
 #include "Utils.h"
 #include <algorithm>
+#include <cstddef>
+#include <stdexcept>
 #include <vector>
 
 namespace blindsolving {
@@ -21,6 +23,20 @@ class CornerCycleSequenceIterator {
    */
   std::vector<CornerRotationAmount> modifications;
 
+  static char rotate(const char& corner,
+                     const CornerRotationAmount& rotation_amount) {
+    switch (rotation_amount) {
+      case CornerRotationAmount::None:
+        return corner;
+      case CornerRotationAmount::Clockwise:
+        return rotateClockwise(corner);
+      case CornerRotationAmount::Counterclockwise:
+        return rotateCounterclockwise(corner);
+      default:
+        throw std::logic_error("Unknown enum value!");
+    }
+  }
+
  public:
   /**
    * @param rotation_amounts The CornerRotationAmount that must be applied to
@@ -33,6 +49,42 @@ class CornerCycleSequenceIterator {
       const std::vector<std::vector<char>>& cycles,
       std::vector<CornerRotationAmount> rotation_amounts);
 
+  /**
+   * Calls visitor with each target of cycle, starting from its counter-th
+   * target and followed by the cycle-closing target, as it appears in the
+   * output of the iterator.
+   */
+  template <typename Visitor>
+  static void visitCycle(const std::vector<char>& cycle, const size_t& counter,
+                         const CornerRotationAmount& rotation_amount,
+                         const CornerRotationAmount& modification,
+                         Visitor&& visitor) {
+    for (size_t j = 0; j < cycle.size(); j++) {
+      const char& target = cycle[(j + counter) % cycle.size()];
+      // rotate the last counter elements by rotation_amount (which wrap around
+      // to the end)
+      visitor(rotate(
+          j >= cycle.size() - counter ? rotate(target, rotation_amount)
+                                      : target,
+          modification));
+    }
+    // add the final cycle-closing target
+    visitor(rotate(rotate(cycle[counter], rotation_amount), modification));
+  }
+
+  /**
+   * Calls visitor with each target of the current output, without allocating.
+   */
+  template <typename Visitor>
+  void visit(Visitor&& visitor) const {
+    const std::vector<std::vector<char>>& cycles = it.getCycles();
+    const std::vector<size_t>& counters = it.getCounters();
+    const std::vector<size_t>& permutation = it.getPermutation();
+    for (size_t i = 0; i < permutation.size(); i++)
+      visitCycle(cycles[permutation[i]], counters[permutation[i]],
+                 rotation_amounts[permutation[i]], modifications[i], visitor);
+  }
+
   /**
    * @return True if the iterator was successfully incremented, and false if the
    * iterator overflowed.
@@ -41,8 +93,24 @@ class CornerCycleSequenceIterator {
 
   std::vector<char> operator*() const;
 
+  const std::vector<std::vector<char>>& getCycles() const;
+
+  const std::vector<CornerRotationAmount>& getRotationAmounts() const;
+
   size_t getPeriod() const;
 
   void reset();
+
+  /**
+   * Moves to the output that would be reached by incrementing index times
+   * after reset().
+   */
+  void seek(const size_t& index);
+
+  /**
+   * @return The index of the current output, such that seek(rank()) does not
+   * change the iterator.
+   */
+  [[nodiscard]] size_t rank() const;
 };
 }  // namespace blindsolving
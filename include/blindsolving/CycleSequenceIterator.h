@@ -4,6 +4,8 @@
 #include "MathUtils.h"
 #include "Utils.h"
 #include <algorithm>
+#include <cassert>
+#include <cstddef>
 #include <numeric>
 #include <vector>
 
@@ -22,6 +24,15 @@ class CycleSequenceIterator {
   mutable std::vector<std::vector<T>> current;
   mutable bool is_current_valid = false;
 
+  /**
+   * @return The number of combinations of counters for each permutation.
+   */
+  size_t getCounterCount() const {
+    size_t counter_count = 1;
+    for (const auto& cycle : cycles) counter_count *= cycle.size();
+    return counter_count;
+  }
+
  public:
   explicit CycleSequenceIterator(const std::vector<std::vector<T>>& cycles)
       : cycles(cycles), current(std::vector<std::vector<T>>{cycles.size()}) {
@@ -83,9 +94,7 @@ class CycleSequenceIterator {
    * before overflow and repetition).
    */
   size_t getPeriod() const {
-    size_t period = utility::factorial(cycles.size());
-    for (const auto& cycle : cycles) period *= cycle.size();
-    return period;
+    return utility::factorial(cycles.size()) * getCounterCount();
   }
 
   void reset() {
@@ -94,6 +103,61 @@ class CycleSequenceIterator {
     is_current_valid = false;
   }
 
+  /**
+   * Moves to the output that would be reached by incrementing index times
+   * after reset(). Outputs are ordered by the lexicographic rank of the
+   * permutation, and then by the counters as a mixed radix number whose least
+   * significant digit is the counter of the first cycle in the permutation,
+   * so the permutation is unranked in the factorial number system like
+   * Permutation::parseRank.
+   */
+  void seek(size_t index) {
+    assert(index < getPeriod());
+    is_current_valid = false;
+    const size_t counter_count = getCounterCount();
+    size_t permutation_rank = index / counter_count;
+    index %= counter_count;
+
+    std::vector<size_t> unused(cycles.size());
+    std::iota(unused.begin(), unused.end(), 0);
+    for (size_t i = 0; i < cycles.size(); ++i) {
+      const size_t coefficient = utility::factorial(cycles.size() - 1 - i);
+      const auto next = unused.begin() + permutation_rank / coefficient;
+      permutation_rank %= coefficient;
+      permutation[i] = *next;
+      unused.erase(next);
+    }
+
+    for (const size_t& cycle_index : permutation) {
+      counters[cycle_index] = index % cycles[cycle_index].size();
+      index /= cycles[cycle_index].size();
+    }
+  }
+
+  /**
+   * @return The index of the current output, such that seek(rank()) does not
+   * change the iterator.
+   */
+  [[nodiscard]] size_t rank() const {
+    size_t permutation_rank = 0;
+    for (size_t i = 0; i < permutation.size(); ++i) {
+      const size_t smaller_later_count =
+          std::count_if(permutation.begin() + i + 1, permutation.end(),
+                        [&](const size_t& cycle_index) {
+                          return cycle_index < permutation[i];
+                        });
+      permutation_rank +=
+          smaller_later_count * utility::factorial(permutation.size() - 1 - i);
+    }
+
+    size_t counter_rank = 0;
+    for (auto it = permutation.rbegin(); it != permutation.rend(); ++it)
+      counter_rank = counter_rank * cycles[*it].size() + counters[*it];
+    return permutation_rank * getCounterCount() + counter_rank;
+  }
+
+  const std::vector<std::vector<T>>& getCycles() const { return cycles; }
+
   const std::vector<size_t>& getPermutation() const { return permutation; }
 
   const std::vector<size_t>& getCounters() const { return counters; }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "CycleSequenceIterator.h"
+#include "Lettering.h"
+#include <cstddef>
 #include <vector>
 
 namespace blindsolving {
@@ -21,12 +23,64 @@ class EdgeCycleSequenceIterator {
   EdgeCycleSequenceIterator(const std::vector<std::vector<char>>& cycles,
                             std::vector<bool> are_even);
 
+  /**
+   * Calls visitor with each target of cycle, starting from its counter-th
+   * target and followed by the cycle-closing target, as it appears in the
+   * output of the iterator.
+   */
+  template <typename Visitor>
+  static void visitCycle(const std::vector<char>& cycle, const size_t& counter,
+                         const bool& is_even, const bool& is_inverted,
+                         Visitor&& visitor) {
+    const auto visit = [&](const char& target) {
+      visitor(is_inverted ? flipEdge(target) : target);
+    };
+    for (size_t j = 0; j < cycle.size(); j++) {
+      const char& target = cycle[(j + counter) % cycle.size()];
+      // for odd cycles, invert the last counter elements (which wrap around to
+      // the end)
+      visit(!is_even && j >= cycle.size() - counter ? flipEdge(target)
+                                                    : target);
+    }
+    // add the final cycle-closing target
+    visit(is_even ? cycle[counter] : flipEdge(cycle[counter]));
+  }
+
+  /**
+   * Calls visitor with each target of the current output, without allocating.
+   */
+  template <typename Visitor>
+  void visit(Visitor&& visitor) const {
+    const std::vector<std::vector<char>>& cycles = it.getCycles();
+    const std::vector<size_t>& counters = it.getCounters();
+    const std::vector<size_t>& permutation = it.getPermutation();
+    for (size_t i = 0; i < permutation.size(); i++)
+      visitCycle(cycles[permutation[i]], counters[permutation[i]],
+                 are_even[permutation[i]], are_inverted[i], visitor);
+  }
+
   bool operator++();
 
   std::vector<char> operator*() const;
 
+  const std::vector<std::vector<char>>& getCycles() const;
+
+  const std::vector<bool>& getAreEven() const;
+
   size_t getPeriod() const;
 
   void reset();
+
+  /**
+   * Moves to the output that would be reached by incrementing index times
+   * after reset().
+   */
+  void seek(const size_t& index);
+
+  /**
+   * @return The index of the current output, such that seek(rank()) does not
+   * change the iterator.
+   */
+  [[nodiscard]] size_t rank() const;
 };
 }  // namespace blindsolving
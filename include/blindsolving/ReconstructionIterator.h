@@ -5,6 +5,8 @@
 #include "CornerRotationAmount.h"
 #include "CycleSequenceIterator.h"
 #include "EdgeCycleSequenceIterator.h"
+#include "StaticVector.h"
+#include <cstddef>
 #include <vector>
 
 namespace blindsolving {
@@ -19,6 +21,13 @@ class ReconstructionIterator {
   const size_t length;
 
  public:
+  /**
+   * The most BlindsolvingMoves that writeTo can write.
+   */
+  static constexpr size_t MaxLength = 64;
+
+  using Buffer = utility::StaticVector<BlindsolvingMove, MaxLength>;
+
   ReconstructionIterator(
       const std::vector<char>& first_edge_cycle,
       const std::vector<std::vector<char>>& edge_cycles,
@@ -27,12 +36,73 @@ class ReconstructionIterator {
       const std::vector<std::vector<char>>& corner_cycles,
       const std::vector<CornerRotationAmount>& rotation_amounts);
 
+  /**
+   * Edge targets at odd positions of a reconstruction are swapped with the
+   * opposite target on the M slice, since the M slice is offset while they
+   * are solved.
+   */
+  static char swapIfNecessary(const char& chr);
+
   bool operator++();
 
   BlindsolvingReconstruction operator*() const;
 
+  /**
+   * Calls visitor with each BlindsolvingMove of the current reconstruction, in
+   * the same order as operator*, without allocating.
+   */
+  template <typename Visitor>
+  void visit(Visitor&& visitor) const {
+    size_t edge_count = 0;
+    const auto visit_edge = [&](const char& edge) {
+      visitor(BlindsolvingMove{
+          true, edge_count++ % 2 == 1 ? swapIfNecessary(edge) : edge});
+    };
+    for (const char& edge : first_edge_cycle) visit_edge(edge);
+    edge_iterator.visit(visit_edge);
+    if (has_parity) visitor(BlindsolvingMove{});
+    const auto visit_corner = [&](const char& corner) {
+      visitor(BlindsolvingMove{false, corner});
+    };
+    for (const char& corner : first_corner_cycle) visit_corner(corner);
+    corner_iterator.visit(visit_corner);
+  }
+
+  /**
+   * Overwrites buffer with the current reconstruction, so that scoring every
+   * reconstruction can reuse one buffer. Requires getLength() <= MaxLength.
+   */
+  void writeTo(Buffer& buffer) const;
+
+  const std::vector<char>& getFirstEdgeCycle() const;
+
+  const EdgeCycleSequenceIterator& getEdgeIterator() const;
+
+  bool hasParity() const;
+
+  const std::vector<char>& getFirstCornerCycle() const;
+
+  const CornerCycleSequenceIterator& getCornerIterator() const;
+
+  /**
+   * @return The number of BlindsolvingMoves in every reconstruction.
+   */
+  size_t getLength() const;
+
   size_t getPeriod() const;
 
   void reset();
+
+  /**
+   * Moves to the reconstruction that would be reached by incrementing index
+   * times after reset(), where index is in [0, getPeriod()).
+   */
+  void seek(const size_t& index);
+
+  /**
+   * @return The index of the current reconstruction, such that seek(rank())
+   * does not change the iterator.
+   */
+  [[nodiscard]] size_t rank() const;
 };
 }  // namespace blindsolving
@@ -4,6 +4,7 @@
 #include "RandomUtils.h"
 #include "TurnSets.h"
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -57,13 +58,13 @@ struct Algorithm : public std::vector<Move> {
    */
   void cancelMoves();
 
-  static Algorithm parse(const std::string& alg);
+  static Algorithm parse(std::string_view alg);
 
   /**
    * @brief Parses the provided string, breaking apart all moves into quarter
    * turns.
    */
-  static Algorithm parseExpanded(const std::string& alg);
+  static Algorithm parseExpanded(std::string_view alg);
 
   [[nodiscard]] Algorithm inv() const;
 
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Algorithm.h"
+#include "CompactMove.h"
+#include <vector>
+
+/**
+ * An Algorithm stored as one byte per Move, for caching large numbers of
+ * solutions.
+ */
+class CompactAlgorithm : public std::vector<CompactMove> {
+ public:
+  CompactAlgorithm() = default;
+
+  explicit CompactAlgorithm(const Algorithm& algorithm);
+
+  [[nodiscard]] Algorithm toAlgorithm() const;
+
+  [[nodiscard]] CompactAlgorithm inv() const;
+
+  /**
+   * Merges adjacent moves of the same layers, removing any that cancel out
+   * entirely. Unlike Algorithm::cancelMoves, this does not convert to standard
+   * form, so the Types of the remaining moves are preserved.
+   */
+  void cancelMoves();
+};
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "CubeRotation.h"
+#include "Face.h"
+#include "Move.h"
+#include "RotationAmount.h"
+#include "RotationAxis.h"
+#include "Slice.h"
+#include "SliceTurn.h"
+#include "Turn.h"
+#include "WideTurn.h"
+#include <cassert>
+#include <cstdint>
+
+/**
+ * A Move packed into a single byte, so that stored Algorithms take a fraction
+ * of the memory and can be iterated without any variant dispatch. Bits 5 and 6
+ * hold the Type, bits 2 to 4 hold the Face, Slice, or RotationAxis, and bits 0
+ * and 1 hold the RotationAmount.
+ */
+class CompactMove {
+ public:
+  /**
+   * The alternatives of Move, in the same order.
+   */
+  enum class Type : uint8_t { Turn, SliceTurn, WideTurn, CubeRotation };
+
+ private:
+  uint8_t value;
+
+  constexpr CompactMove(const Type& type, const uint8_t& layer,
+                        const RotationAmount& rotation_amount)
+      : value(static_cast<uint8_t>(static_cast<uint8_t>(type) << 5 |
+                                   layer << 2 |
+                                   static_cast<uint8_t>(rotation_amount))) {}
+
+ public:
+  constexpr CompactMove() : value(0) {}
+
+  constexpr explicit CompactMove(const Turn& turn)
+      : CompactMove(Type::Turn, static_cast<uint8_t>(turn.face),
+                    turn.rotation_amount) {}
+
+  constexpr explicit CompactMove(const SliceTurn& slice_turn)
+      : CompactMove(Type::SliceTurn, static_cast<uint8_t>(slice_turn.slice),
+                    slice_turn.rotation_amount) {}
+
+  constexpr explicit CompactMove(const WideTurn& wide_turn)
+      : CompactMove(Type::WideTurn, static_cast<uint8_t>(wide_turn.face),
+                    wide_turn.rotation_amount) {}
+
+  constexpr explicit CompactMove(const CubeRotation& cube_rotation)
+      : CompactMove(Type::CubeRotation,
+                    static_cast<uint8_t>(cube_rotation.rotation_axis),
+                    cube_rotation.rotation_amount) {}
+
+  explicit CompactMove(const Move& move);
+
+  [[nodiscard]] constexpr bool operator==(const CompactMove& other) const =
+      default;
+
+  [[nodiscard]] constexpr Type getType() const {
+    return static_cast<Type>(value >> 5);
+  }
+
+  /**
+   * @return Whether this and other move the same layers in the same way, up to
+   * their RotationAmounts, so that they can be merged into a single move.
+   */
+  [[nodiscard]] constexpr bool isSameLayer(const CompactMove& other) const {
+    return (value >> 2) == (other.value >> 2);
+  }
+
+  [[nodiscard]] constexpr RotationAmount getRotationAmount() const {
+    return static_cast<RotationAmount>(value & 0b11);
+  }
+
+  constexpr void setRotationAmount(const RotationAmount& rotation_amount) {
+    value = (value & ~0b11) | static_cast<uint8_t>(rotation_amount);
+  }
+
+  [[nodiscard]] constexpr Turn getTurn() const {
+    assert(getType() == Type::Turn);
+    return {static_cast<Face>(value >> 2 & 0b111), getRotationAmount()};
+  }
+
+  [[nodiscard]] constexpr SliceTurn getSliceTurn() const {
+    assert(getType() == Type::SliceTurn);
+    return {static_cast<Slice>(value >> 2 & 0b111), getRotationAmount()};
+  }
+
+  [[nodiscard]] constexpr WideTurn getWideTurn() const {
+    assert(getType() == Type::WideTurn);
+    return {static_cast<Face>(value >> 2 & 0b111), getRotationAmount()};
+  }
+
+  [[nodiscard]] constexpr CubeRotation getCubeRotation() const {
+    assert(getType() == Type::CubeRotation);
+    return {static_cast<RotationAxis>(value >> 2 & 0b111),
+            getRotationAmount()};
+  }
+
+  [[nodiscard]] constexpr CompactMove inv() const {
+    CompactMove inverse = *this;
+    inverse.setRotationAmount(-getRotationAmount());
+    return inverse;
+  }
+
+  [[nodiscard]] Move toMove() const;
+};
+
+static_assert(sizeof(CompactMove) == 1);
@@ -1,8 +1,11 @@
 #pragma once
 
 #include "Algorithm.h"
+#include "CompactAlgorithm.h"
+#include "CompactMove.h"
 #include "CornerLocation.h"
 #include "CornerPiece.h"
+#include "CornerRotationAmount.h"
 #include "CubeOrientation.h"
 #include "CubeRotation.h"
 #include "EdgeLocation.h"
@@ -13,7 +16,10 @@
 #include "Turn.h"
 #include "WideTurn.h"
 #include <array>
+#include <cassert>
 #include <cstddef>
+#include <cstdint>
+#include <stdexcept>
 #include <string>
 
 class Cube {
@@ -99,6 +105,10 @@ class Cube {
 
   void apply(const Algorithm& algorithm);
 
+  void apply(const CompactMove& move);
+
+  void apply(const CompactAlgorithm& algorithm);
+
   void scramble();
 
   void setSolved();
@@ -111,6 +121,10 @@ class Cube {
 
   [[nodiscard]] bool isStandardOrientation() const;
 
+  [[nodiscard]] const CubeOrientation& getOrientation() const {
+    return orientation;
+  }
+
   /**
    * @brief Compares the edges, corners, and orientation for equality
    */
@@ -173,6 +187,102 @@ class Cube {
   }
 };
 
+/**
+ * The index of an EdgeLocation in Cube::EdgeLocationOrder and whether the
+ * EdgeLocation is flipped relative to the one stored there.
+ */
+struct EdgeSlot {
+  uint8_t index;
+  bool is_flipped;
+};
+
+/**
+ * The index of a CornerLocation in Cube::CornerLocationOrder and the rotation
+ * that must be applied to the CornerPiece stored there to read it from the
+ * CornerLocation.
+ */
+struct CornerSlot {
+  uint8_t index;
+  CornerRotationAmount rotation_amount;
+};
+
+namespace detail {
+/**
+ * Used for combinations of Faces that do not correspond to a location.
+ */
+static constexpr uint8_t InvalidSlot = 0xFF;
+
+consteval std::array<std::array<EdgeSlot, 6>, 6> getEdgeSlots() {
+  std::array<std::array<EdgeSlot, 6>, 6> edge_slots{};
+  for (auto& row : edge_slots) row.fill({InvalidSlot, false});
+  for (uint8_t i = 0; i < Cube::EdgeLocationOrder.size(); ++i) {
+    const auto [first, second] = Cube::EdgeLocationOrder[i];
+    edge_slots[static_cast<uint8_t>(first)][static_cast<uint8_t>(second)] = {
+        i, false};
+    edge_slots[static_cast<uint8_t>(second)][static_cast<uint8_t>(first)] = {
+        i, true};
+  }
+  return edge_slots;
+}
+
+consteval std::array<std::array<std::array<CornerSlot, 6>, 6>, 6>
+getCornerSlots() {
+  std::array<std::array<std::array<CornerSlot, 6>, 6>, 6> corner_slots{};
+  for (auto& plane : corner_slots)
+    for (auto& row : plane) row.fill({InvalidSlot, CornerRotationAmount::None});
+  for (uint8_t i = 0; i < Cube::CornerLocationOrder.size(); ++i) {
+    for (const CornerRotationAmount& rotation_amount :
+         {CornerRotationAmount::None, CornerRotationAmount::Clockwise,
+          CornerRotationAmount::Counterclockwise}) {
+      const auto [first, second, third] =
+          Cube::CornerLocationOrder[i].rotate(rotation_amount);
+      // reading from a location that is rotated clockwise relative to the
+      // slot means the piece must also be read rotated clockwise
+      corner_slots[static_cast<uint8_t>(first)][static_cast<uint8_t>(second)]
+                  [static_cast<uint8_t>(third)] = {i, rotation_amount};
+    }
+  }
+  return corner_slots;
+}
+}  // namespace detail
+
+/**
+ * EdgeSlots[first][second] is the EdgeSlot of the EdgeLocation {first, second}.
+ */
+static constexpr std::array<std::array<EdgeSlot, 6>, 6> EdgeSlots =
+    detail::getEdgeSlots();
+
+/**
+ * CornerSlots[first][second][third] is the CornerSlot of the CornerLocation
+ * {first, second, third}.
+ */
+static constexpr std::array<std::array<std::array<CornerSlot, 6>, 6>, 6>
+    CornerSlots = detail::getCornerSlots();
+
+/**
+ * @throws std::invalid_argument If the EdgeLocation is not valid.
+ */
+constexpr EdgeSlot getEdgeSlot(const EdgeLocation& edge_location) {
+  const EdgeSlot& slot = EdgeSlots[static_cast<uint8_t>(edge_location.first)]
+                                  [static_cast<uint8_t>(edge_location.second)];
+  if (slot.index == detail::InvalidSlot)
+    throw std::invalid_argument("EdgeLocation not found!");
+  return slot;
+}
+
+/**
+ * @throws std::invalid_argument If the CornerLocation is not valid.
+ */
+constexpr CornerSlot getCornerSlot(const CornerLocation& corner_location) {
+  const CornerSlot& slot =
+      CornerSlots[static_cast<uint8_t>(corner_location.first)]
+                 [static_cast<uint8_t>(corner_location.second)]
+                 [static_cast<uint8_t>(corner_location.third)];
+  if (slot.index == detail::InvalidSlot)
+    throw std::invalid_argument("CornerLocation not found!");
+  return slot;
+}
+
 namespace std {
 template <>
 struct hash<Cube> {
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Algorithm.h"
+#include "Cube.h"
+#include "CubeOrientation.h"
+#include "CubeRotation.h"
+#include "CubieCube.h"
+#include "Move.h"
+#include "SliceTurn.h"
+#include "Turn.h"
+#include "WideTurn.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * A structure-of-arrays collection of Cubes that all share the same
+ * CubeOrientation. For each edge slot (in the order of Cube::EdgeLocationOrder)
+ * and each corner slot (in the order of Cube::CornerLocationOrder), the
+ * CubieCube bytes of every Cube are stored contiguously. This way each Move is
+ * dispatched once for the whole batch, a Turn only permutes the slot arrays,
+ * and reorienting the pieces is a simple loop over all Cubes that the compiler
+ * can vectorize.
+ */
+class CubeBatch {
+ private:
+  std::array<std::vector<uint8_t>, CubieCube::EdgeCount> edges;
+  std::array<std::vector<uint8_t>, CubieCube::CornerCount> corners;
+  CubeOrientation orientation;
+  size_t count;
+
+ public:
+  /**
+   * @brief Creates a batch of count solved Cubes.
+   */
+  explicit CubeBatch(const size_t& count);
+
+  /**
+   * @throws std::invalid_argument If the Cubes do not all have the same
+   * CubeOrientation.
+   */
+  explicit CubeBatch(const std::vector<Cube>& cubes);
+
+  [[nodiscard]] size_t size() const { return count; }
+
+  void apply(const Turn& turn);
+
+  void apply(const SliceTurn& slice_turn);
+
+  void apply(const WideTurn& wide_turn);
+
+  void apply(const CubeRotation& cube_rotation);
+
+  void apply(const Move& move);
+
+  void apply(const Algorithm& algorithm);
+
+  /**
+   * @return For each Cube, whether its pieces are solved (ignoring the
+   * CubeOrientation, like Cube::isSolved).
+   */
+  [[nodiscard]] std::vector<bool> isSolved() const;
+
+  /**
+   * @return The pieces of the Cube at the given index.
+   */
+  [[nodiscard]] CubieCube operator[](const size_t& idx) const;
+};
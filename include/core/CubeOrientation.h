@@ -9,23 +9,36 @@
 #include "WideTurn.h"
 #include <cstddef>
 #include <optional>
+#include <stdexcept>
 #include <utility>
 
 struct CubeOrientation {
   Face top;    // the face that is now on top
   Face front;  // the face that is now in the front
 
-  [[nodiscard]] bool isValid() const;
+  [[nodiscard]] constexpr bool isValid() const {
+    return top != front && top != getOpposite(front);
+  }
 
-  bool operator==(const CubeOrientation& other) const;
+  constexpr bool operator==(const CubeOrientation& other) const {
+    return top == other.top && front == other.front;
+  }
 
-  [[nodiscard]] Face getRightFace() const;
+  [[nodiscard]] constexpr Face getRightFace() const {
+    return getRight(top, front);
+  }
 
-  [[nodiscard]] Face getBackFace() const;
+  [[nodiscard]] constexpr Face getBackFace() const {
+    return getOpposite(front);
+  }
 
-  [[nodiscard]] Face getLeftFace() const;
+  [[nodiscard]] constexpr Face getLeftFace() const {
+    return getLeft(top, front);
+  }
 
-  [[nodiscard]] Face getBottomFace() const;
+  [[nodiscard]] constexpr Face getBottomFace() const {
+    return getOpposite(top);
+  }
 
   static constexpr CubeOrientation identity() { return {Face::U, Face::F}; }
 
@@ -54,7 +67,24 @@ struct CubeOrientation {
    * @brief Converts the given Face in this CubeOrientation to the equivalent
    * Face in the identity CubeOrientation
    */
-  [[nodiscard]] Face apply(const Face& face) const;
+  [[nodiscard]] constexpr Face apply(const Face& face) const {
+    switch (face) {
+      case Face::U:
+        return top;
+      case Face::F:
+        return front;
+      case Face::R:
+        return getRightFace();
+      case Face::B:
+        return getBackFace();
+      case Face::L:
+        return getLeftFace();
+      case Face::D:
+        return getBottomFace();
+      default:
+        throw std::logic_error("Unknown enum value!");
+    }
+  }
 
   /**
    * @brief Converts the given Slice in this CubeOrientation to the equivalent
@@ -65,9 +95,12 @@ struct CubeOrientation {
 
   /**
    * @brief Converts the given Turn in this CubeOrientation to the equivalent
-   * Turn in the identity CubeOrientation
+   * Turn in the identity CubeOrientation. This conjugates the Turn by the
+   * rotation of this CubeOrientation.
    */
-  [[nodiscard]] Turn apply(const Turn& turn) const;
+  [[nodiscard]] constexpr Turn apply(const Turn& turn) const {
+    return Turn{apply(turn.face), turn.rotation_amount};
+  }
 
   /**
    * @brief Converts the given Turn in this CubeOrientation to the equivalent
@@ -3,6 +3,7 @@
 #include "RotationAmount.h"
 #include "RotationAxis.h"
 #include <string>
+#include <string_view>
 #include <utility>
 
 struct CubeRotation {
@@ -20,5 +21,5 @@ struct CubeRotation {
    * CubeRotation. If it was not possible to parse a CubeRotation, then the
    * number of characters consumed will be zero.
    */
-  static std::pair<size_t, CubeRotation> parse(const std::string& str);
+  static std::pair<size_t, CubeRotation> parse(std::string_view str);
 };
@@ -0,0 +1,257 @@
+#pragma once
+
+#include "CornerLocation.h"
+#include "CornerPiece.h"
+#include "CornerRotationAmount.h"
+#include "Cube.h"
+#include "EdgeLocation.h"
+#include "EdgePiece.h"
+#include "Face.h"
+#include "RotationAmount.h"
+#include "Turn.h"
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * Describes how a single Turn moves the pieces of a Cube. After the Turn, the
+ * edge slot i (i.e. Cube::EdgeLocationOrder[i]) holds the piece that was
+ * previously in slot edge_sources[i], flipped if edge_flips[i] is 1. Similarly,
+ * corner slot i holds the piece that was previously in slot corner_sources[i],
+ * rotated clockwise corner_rotations[i] times.
+ *
+ * The edge arrays are padded to 16 bytes (with the padding mapping to itself)
+ * so that the sources can be used directly as a byte shuffle mask for the 16
+ * byte edge lane of a CubieCube, and likewise for the 8 byte corner lane.
+ */
+struct TurnTable {
+  alignas(16) std::array<uint8_t, 16> edge_sources;
+  alignas(16) std::array<uint8_t, 16> edge_flips;
+  alignas(8) std::array<uint8_t, 8> corner_sources;
+  alignas(8) std::array<uint8_t, 8> corner_rotations;
+};
+
+namespace detail {
+constexpr std::array<EdgeLocation, 4> getEdgeLocationCycle(const Face& face) {
+  using enum Face;
+  switch (face) {
+    case U:
+      return {{{U, B}, {U, R}, {U, F}, {U, L}}};
+    case F:
+      return {{{F, U}, {F, R}, {F, D}, {F, L}}};
+    case R:
+      return {{{R, U}, {R, B}, {R, D}, {R, F}}};
+    case B:
+      return {{{B, U}, {B, L}, {B, D}, {B, R}}};
+    case L:
+      return {{{L, U}, {L, F}, {L, D}, {L, B}}};
+    case D:
+      return {{{D, F}, {D, R}, {D, B}, {D, L}}};
+    default:
+      throw std::logic_error("Unknown enum value!");
+  }
+}
+
+constexpr std::array<CornerLocation, 4> getCornerLocationCycle(
+    const Face& face) {
+  using enum Face;
+  switch (face) {
+    case U:
+      return {{{U, L, B}, {U, B, R}, {U, R, F}, {U, F, L}}};
+    case F:
+      return {{{F, L, U}, {F, U, R}, {F, R, D}, {F, D, L}}};
+    case R:
+      return {{{R, F, U}, {R, U, B}, {R, B, D}, {R, D, F}}};
+    case B:
+      return {{{B, R, U}, {B, U, L}, {B, L, D}, {B, D, R}}};
+    case L:
+      return {{{L, B, U}, {L, U, F}, {L, F, D}, {L, D, B}}};
+    case D:
+      return {{{D, L, F}, {D, F, R}, {D, R, B}, {D, B, L}}};
+    default:
+      throw std::logic_error("Unknown enum value!");
+  }
+}
+
+constexpr TurnTable getTurnTable(const Face& face,
+                                 const RotationAmount& rotation_amount) {
+  TurnTable table{};
+  for (uint8_t i = 0; i < table.edge_sources.size(); ++i)
+    table.edge_sources[i] = i;  // including the padding
+  for (uint8_t i = 0; i < table.corner_sources.size(); ++i)
+    table.corner_sources[i] = i;
+
+  const std::array<EdgeLocation, 4> edge_cycle = getEdgeLocationCycle(face);
+  const std::array<CornerLocation, 4> corner_cycle =
+      getCornerLocationCycle(face);
+  const uint8_t steps = static_cast<uint8_t>(rotation_amount);
+  for (uint8_t i = 0; i < 4; ++i) {
+    // the piece at edge_cycle[i] moves to edge_cycle[(i + steps) % 4]
+    const auto [from_edge, from_flipped] = getEdgeSlot(edge_cycle[i]);
+    const auto [to_edge, to_flipped] = getEdgeSlot(edge_cycle[(i + steps) % 4]);
+    table.edge_sources[to_edge] = from_edge;
+    table.edge_flips[to_edge] = from_flipped != to_flipped ? 1 : 0;
+
+    const auto [from_corner, from_rotation] = getCornerSlot(corner_cycle[i]);
+    const auto [to_corner, to_rotation] =
+        getCornerSlot(corner_cycle[(i + steps) % 4]);
+    table.corner_sources[to_corner] = from_corner;
+    table.corner_rotations[to_corner] =
+        static_cast<uint8_t>(from_rotation - to_rotation);
+  }
+  return table;
+}
+
+consteval std::array<TurnTable, 24> getTurnTables() {
+  std::array<TurnTable, 24> tables{};
+  for (uint8_t face = 0; face < 6; ++face)
+    for (uint8_t rotation_amount = 0; rotation_amount < 4; ++rotation_amount)
+      tables[4 * face + rotation_amount] =
+          getTurnTable(static_cast<Face>(face),
+                       static_cast<RotationAmount>(rotation_amount));
+  return tables;
+}
+}  // namespace detail
+
+/**
+ * The TurnTable for every combination of Face and RotationAmount (including
+ * RotationAmount::None), indexed by getTurnTableIndex.
+ */
+static constexpr std::array<TurnTable, 24> TurnTables =
+    detail::getTurnTables();
+
+constexpr uint8_t getTurnTableIndex(const Turn& turn) {
+  return 4 * static_cast<uint8_t>(turn.face) +
+         static_cast<uint8_t>(turn.rotation_amount);
+}
+
+/**
+ * A compact representation of the pieces of a Cube. Each of the 12 edge slots
+ * and 8 corner slots (in the order of Cube::EdgeLocationOrder and
+ * Cube::CornerLocationOrder respectively) is a single byte whose upper 4 bits
+ * are the index of the piece (in Cube::StartingEdgePieces or
+ * Cube::StartingCornerPieces) and whose lower 4 bits are its orientation
+ * (0 or 1 for edges, number of clockwise rotations for corners).
+ *
+ * Unlike Cube, a CubieCube does not track its CubeOrientation, so Turns are
+ * always applied relative to the identity CubeOrientation.
+ *
+ * The edges are padded to 16 bytes so that they fill a single SIMD lane. The
+ * padding bytes are always zero.
+ */
+class CubieCube {
+ public:
+  static constexpr uint8_t OrientationMask = 0x0F;
+  static constexpr size_t EdgeCount = Cube::EdgeLocationOrder.size();
+  static constexpr size_t CornerCount = Cube::CornerLocationOrder.size();
+
+ private:
+  alignas(16) std::array<uint8_t, 16> edges;
+  alignas(8) std::array<uint8_t, 8> corners;
+
+ public:
+  constexpr CubieCube() : edges(), corners() {
+    for (uint8_t i = 0; i < EdgeCount; ++i) edges[i] = i << 4;
+    for (uint8_t i = 0; i < CornerCount; ++i) corners[i] = i << 4;
+  }
+
+  constexpr CubieCube(const std::array<uint8_t, 16>& edges,
+                      const std::array<uint8_t, 8>& corners)
+      : edges(edges), corners(corners) {}
+
+  /**
+   * @brief Converts the pieces of the given Cube. The CubeOrientation of the
+   * Cube is ignored.
+   */
+  explicit CubieCube(const Cube& cube);
+
+  /**
+   * @return The equivalent Cube in the identity CubeOrientation.
+   */
+  [[nodiscard]] Cube toCube() const;
+
+  /**
+   * @brief Applies the given Turn with applyVectorized when possible, otherwise
+   * with applyScalar.
+   */
+  constexpr void apply(const Turn& turn) {
+    if (std::is_constant_evaluated())
+      applyScalar(turn);
+    else
+      applyVectorized(turn);
+  }
+
+  constexpr void applyScalar(const Turn& turn) {
+    const TurnTable& table = TurnTables[getTurnTableIndex(turn)];
+    const std::array<uint8_t, 16> old_edges = edges;
+    for (size_t i = 0; i < EdgeCount; ++i)
+      edges[i] = old_edges[table.edge_sources[i]] ^ table.edge_flips[i];
+
+    const std::array<uint8_t, 8> old_corners = corners;
+    for (size_t i = 0; i < CornerCount; ++i) {
+      const uint8_t corner = old_corners[table.corner_sources[i]];
+      const uint8_t rotation =
+          ((corner & OrientationMask) + table.corner_rotations[i]) % 3;
+      corners[i] = (corner & ~OrientationMask) | rotation;
+    }
+  }
+
+  /**
+   * @brief Applies the given Turn using a single byte shuffle for each of the
+   * edge and corner lanes, followed by an orientation xor (edges) or add mod 3
+   * (corners). Falls back to applyScalar if the CPU does not support SSSE3.
+   */
+  void applyVectorized(const Turn& turn);
+
+  [[nodiscard]] constexpr bool isSolved() const {
+    return *this == CubieCube{};
+  }
+
+  [[nodiscard]] constexpr uint8_t getEdgePiece(const size_t& idx) const {
+    assert(idx < EdgeCount);
+    return edges[idx] >> 4;
+  }
+
+  [[nodiscard]] constexpr bool isEdgeFlipped(const size_t& idx) const {
+    assert(idx < EdgeCount);
+    return (edges[idx] & OrientationMask) != 0;
+  }
+
+  [[nodiscard]] constexpr uint8_t getCornerPiece(const size_t& idx) const {
+    assert(idx < CornerCount);
+    return corners[idx] >> 4;
+  }
+
+  [[nodiscard]] constexpr CornerRotationAmount getCornerRotation(
+      const size_t& idx) const {
+    assert(idx < CornerCount);
+    return static_cast<CornerRotationAmount>(corners[idx] & OrientationMask);
+  }
+
+  [[nodiscard]] constexpr const std::array<uint8_t, 16>& getEdges() const {
+    return edges;
+  }
+
+  [[nodiscard]] constexpr const std::array<uint8_t, 8>& getCorners() const {
+    return corners;
+  }
+
+  [[nodiscard]] constexpr bool operator==(const CubieCube& other) const =
+      default;
+};
+
+namespace std {
+template <>
+struct hash<CubieCube> {
+  size_t operator()(const CubieCube& cubie_cube) const {
+    size_t hash = 0;
+    for (const uint8_t& edge : cubie_cube.getEdges()) hash = 31 * hash + edge;
+    for (const uint8_t& corner : cubie_cube.getCorners())
+      hash = 31 * hash + corner;
+    return hash;
+  }
+};
+}  // namespace std
@@ -1,10 +1,12 @@
 #pragma once
 
 #include "RotationAxis.h"
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 
 enum class Face : uint8_t { U, F, R, B, L, D };
@@ -29,10 +31,30 @@ constexpr Face getOpposite(const Face& face) {
   }
 }
 
-// TODO: make these functions constexpr
-Face getLeft(const Face& top, const Face& front);
+constexpr Face getLeft(const Face& top, const Face& front) {
+  using enum Face;
+  // the Faces around each corner in clockwise order, as in
+  // Cube::CornerLocationOrder
+  /** static **/ constexpr std::array<std::array<Face, 3>, 8> Corners{
+      {{U, L, B},
+       {U, B, R},
+       {U, R, F},
+       {U, F, L},
+       {D, L, F},
+       {D, F, R},
+       {D, R, B},
+       {D, B, L}}};
+  for (const auto& [first, second, third] : Corners) {
+    if (top == first && front == second) return third;
+    if (top == second && front == third) return first;
+    if (top == third && front == first) return second;
+  }
+  throw std::invalid_argument("Provided top and front faces are inconsistent!");
+}
 
-Face getRight(const Face& top, const Face& right);
+constexpr Face getRight(const Face& top, const Face& front) {
+  return getOpposite(getLeft(top, front));
+}
 
 /**
  * @brief Computes the RotationAxis that results from applying a wide turn on
@@ -69,6 +91,6 @@ std::string toStrLower(const Face& face);
  * was not possible to parse a Face, then the number of characters consumed will
  * be zero.
  */
-std::pair<size_t, Face> parseFace(const std::string& str);
+std::pair<size_t, Face> parseFace(std::string_view str);
 
-std::pair<size_t, Face> parseWideFace(const std::string& str);
+std::pair<size_t, Face> parseWideFace(std::string_view str);
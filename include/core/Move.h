@@ -5,6 +5,7 @@
 #include "Turn.h"
 #include "WideTurn.h"
 #include <string>
+#include <string_view>
 #include <variant>
 
 struct Move : public std::variant<Turn, SliceTurn, WideTurn, CubeRotation> {
@@ -41,5 +42,5 @@ struct Move : public std::variant<Turn, SliceTurn, WideTurn, CubeRotation> {
    * was not possible to parse a Move, then the number of characters consumed
    * will be zero.
    */
-  static std::pair<size_t, Move> parse(const std::string& str);
+  static std::pair<size_t, Move> parse(std::string_view str);
 };
\ No newline at end of file
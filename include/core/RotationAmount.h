@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 
 enum class RotationAmount : uint8_t {
@@ -71,4 +72,4 @@ constexpr RotationAmount operator-(const RotationAmount& rotation_amount) {
  * number of characters consumed will be zero and the RotationAmount will be
  * Clockwise.
  */
-std::pair<size_t, RotationAmount> parseRotationAmount(const std::string& str);
+std::pair<size_t, RotationAmount> parseRotationAmount(std::string_view str);
@@ -3,6 +3,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <utility>
 
 enum class RotationAxis : uint8_t { X, Y, Z };
@@ -14,4 +15,4 @@ std::string toStr(const RotationAxis& rotationAxis);
  * If it was not possible to parse a RotationAxis, then the number of characters
  * consumed will be zero.
  */
-std::pair<size_t, RotationAxis> parseRotationAxis(const std::string& str);
+std::pair<size_t, RotationAxis> parseRotationAxis(std::string_view str);
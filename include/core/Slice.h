@@ -6,6 +6,7 @@
 #include <cstdint>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 
 enum class Slice : uint8_t { M, E, S };
@@ -75,4 +76,4 @@ std::string toStr(const Slice& slice);
  * was not possible to parse a Slice, then the number of characters consumed
  * will be zero.
  */
-std::pair<size_t, Slice> parseSlice(const std::string& str);
+std::pair<size_t, Slice> parseSlice(std::string_view str);
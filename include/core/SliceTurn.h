@@ -6,6 +6,7 @@
 #include "Turn.h"
 #include <cstddef>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <utility>
 
@@ -31,5 +32,5 @@ struct SliceTurn {
    * SliceTurn. If it was not possible to parse a SliceTurn, then the number
    * of characters consumed will be zero.
    */
-  static std::pair<size_t, SliceTurn> parse(const std::string& str);
+  static std::pair<size_t, SliceTurn> parse(std::string_view str);
 };
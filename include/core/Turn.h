@@ -5,6 +5,7 @@
 #include "RotationAmount.h"
 #include <cstddef>
 #include <string>
+#include <string_view>
 #include <utility>
 
 struct Turn {
@@ -39,5 +40,5 @@ struct Turn {
    * was not possible to parse a Turn, then the number of characters consumed
    * will be zero.
    */
-  static std::pair<size_t, Turn> parse(const std::string& str);
+  static std::pair<size_t, Turn> parse(std::string_view str);
 };
@@ -6,6 +6,7 @@
 #include "Turn.h"
 #include <cstddef>
 #include <string>
+#include <string_view>
 #include <utility>
 
 struct WideTurn {
@@ -30,5 +31,5 @@ struct WideTurn {
    * If it was not possible to parse a WideTurn, then the number of characters
    * consumed will be zero.
    */
-  static std::pair<size_t, WideTurn> parse(const std::string& str);
+  static std::pair<size_t, WideTurn> parse(std::string_view str);
 };
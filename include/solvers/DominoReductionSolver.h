@@ -2,11 +2,30 @@
 
 #include "Algorithm.h"
 #include "Cube.h"
+#include "TrackedCube.h"
+#include "Turn.h"
+#include <cstdint>
 
 namespace solvers {
+/**
+ * @return The domino reduction descriptor (corner orientation and E slice edge
+ * combination) of the given Cube.
+ */
+uint32_t getDominoReductionDescriptor(const Cube& cube);
+
+/**
+ * @return The domino reduction descriptor after applying the given Turn, which
+ * may be any Turn.
+ */
+uint32_t applyDominoReductionTurn(const uint32_t& descriptor, const Turn& turn);
+
 bool isDominoReduced(const Cube& cube);
 
+bool isDominoReduced(const TrackedCube& cube);
+
 Algorithm solveDominoReduction(Cube cube);
 
+Algorithm solveDominoReduction(const TrackedCube& cube);
+
 void runDominoReductionSolverTests();
 }  // namespace solvers
\ No newline at end of file
@@ -2,11 +2,30 @@
 
 #include "Algorithm.h"
 #include "Cube.h"
+#include "TrackedCube.h"
+#include "Turn.h"
+#include <cstdint>
 
 namespace solvers {
+/**
+ * @return The edge orientation descriptor of the given Cube, which is 0 if and
+ * only if its edges are oriented.
+ */
+uint16_t getEdgeOrientationDescriptor(const Cube& cube);
+
+/**
+ * @return The edge orientation descriptor after applying the given Turn, which
+ * may be any Turn.
+ */
+uint16_t applyEdgeOrientationTurn(const uint16_t& descriptor, const Turn& turn);
+
 bool areEdgesOriented(const Cube& cube);
 
+bool areEdgesOriented(const TrackedCube& cube);
+
 Algorithm solveEdgeOrientation(const Cube& cube);
 
+Algorithm solveEdgeOrientation(const TrackedCube& cube);
+
 void runEdgeOrientationSolverTests();
 }  // namespace solvers
@@ -2,11 +2,31 @@
 
 #include "Algorithm.h"
 #include "Cube.h"
+#include "TrackedCube.h"
+#include "Turn.h"
+#include <cstdint>
 
 namespace solvers {
+/**
+ * @return The half turn reduction descriptor of the given Cube, which must be
+ * domino reduced.
+ */
+uint16_t getHalfTurnReductionDescriptor(const Cube& cube);
+
+/**
+ * @return The half turn reduction descriptor after applying the given Turn,
+ * which must preserve domino reduction.
+ */
+uint16_t applyHalfTurnReductionTurn(const uint16_t& descriptor,
+                                    const Turn& turn);
+
 bool isHalfTurnReduced(const Cube& cube);
 
+bool isHalfTurnReduced(const TrackedCube& cube);
+
 Algorithm solveHalfTurnReduction(Cube cube);
 
+Algorithm solveHalfTurnReduction(const TrackedCube& cube);
+
 void runHalfTurnReductionSolverTests();
 }  // namespace solvers
@@ -4,58 +4,40 @@
 #include "BidirectionalStaticVector.h"
 #include "CornerLocation.h"
 #include "Cube.h"
+#include "CubieCube.h"
 #include "EdgeLocation.h"
 #include "Face.h"
 #include "HeapArray.h"
+#include "LookupTableFile.h"
 #include "MathUtils.h"
 #include "PackedBitsArray.h"
 #include "Turn.h"
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
 #include <fstream>
 #include <limits>
+#include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace solvers {
 consteval uint8_t getEdgeIndex(const Face& first, const Face& second) {
-  const EdgeLocation location{first, second};
-  uint8_t idx = std::find(Cube::EdgeLocationOrder.begin(),
-                          Cube::EdgeLocationOrder.end(), location) -
-                Cube::EdgeLocationOrder.begin();
-  if (idx != Cube::EdgeLocationOrder.size()) return idx;
-
-  idx = std::find(Cube::EdgeLocationOrder.begin(),
-                  Cube::EdgeLocationOrder.end(), location.flip()) -
-        Cube::EdgeLocationOrder.begin();
-  assert(idx != Cube::EdgeLocationOrder.size());
-  return idx;
+  return getEdgeSlot({first, second}).index;
 }
 
 consteval uint8_t getCornerIndex(const Face& first, const Face& second,
                                  const Face& third) {
-  const CornerLocation location{first, second, third};
-  uint8_t idx = std::find(Cube::CornerLocationOrder.begin(),
-                          Cube::CornerLocationOrder.end(), location) -
-                Cube::CornerLocationOrder.begin();
-  if (idx != Cube::CornerLocationOrder.size()) return idx;
-
-  idx = std::find(Cube::CornerLocationOrder.begin(),
-                  Cube::CornerLocationOrder.end(), location.rotateClockwise()) -
-        Cube::CornerLocationOrder.begin();
-  if (idx != Cube::CornerLocationOrder.size()) return idx;
-
-  idx = std::find(Cube::CornerLocationOrder.begin(),
-                  Cube::CornerLocationOrder.end(),
-                  location.rotateCounterclockwise()) -
-        Cube::CornerLocationOrder.begin();
-  assert(idx != Cube::CornerLocationOrder.size());
-  return idx;
+  return getCornerSlot({first, second, third}).index;
 }
 
 constexpr std::array<uint8_t, 4> getEdgeCycle(const Face& face) {
@@ -164,6 +146,129 @@ constexpr void cycleTurn(std::array<T, n>& data,
   }
 }
 
+namespace detail {
+template <auto PossibleTurns>
+consteval std::array<uint8_t, 24> getTurnIndices() {
+  std::array<uint8_t, 24> turn_indices{};
+  turn_indices.fill(PossibleTurns.size());
+  for (uint8_t i = 0; i < PossibleTurns.size(); ++i)
+    turn_indices[getTurnTableIndex(PossibleTurns[i])] = i;
+  return turn_indices;
+}
+}  // namespace detail
+
+/**
+ * The index of every Turn in PossibleTurns, indexed by getTurnTableIndex.
+ * Turns that are not in PossibleTurns have index PossibleTurns.size().
+ */
+template <auto PossibleTurns>
+static constexpr std::array<uint8_t, 24> TurnIndices =
+    detail::getTurnIndices<PossibleTurns>();
+
+/**
+ * Precomputes applyTurn for every descriptor and every Turn of PossibleTurns,
+ * so that applying a Turn is a single lookup rather than decoding the
+ * descriptor, cycling it and re-encoding it. The table has a row for every
+ * descriptor, so larger groups should instead combine a MoveTable for each of
+ * their coordinates with a ProductMoveTable.
+ *
+ * The table is built at runtime, since building it at compile time would
+ * cost as much as the searches that it speeds up.
+ */
+template <auto DescriptorCount, auto PossibleTurns, auto applyTurn>
+class MoveTable {
+ public:
+  using Uint = decltype(DescriptorCount);
+
+ private:
+  using Element = utility::get_smallest_unsigned_int_t<utility::requiredBits(
+      DescriptorCount)>;
+
+  utility::HeapArray<std::array<Element, PossibleTurns.size()>,
+                     DescriptorCount>
+      next_descriptors;
+
+ public:
+  MoveTable() {
+    for (size_t descriptor = 0; descriptor < DescriptorCount; ++descriptor)
+      for (size_t i = 0; i < PossibleTurns.size(); ++i)
+        next_descriptors[descriptor][i] =
+            applyTurn(static_cast<Uint>(descriptor), PossibleTurns[i]);
+  }
+
+  /**
+   * @return The descriptor after applying PossibleTurns[turn_index].
+   */
+  [[nodiscard]] Uint operator()(const Uint& descriptor,
+                                const uint8_t& turn_index) const {
+    return next_descriptors[descriptor][turn_index];
+  }
+
+  /**
+   * @return The descriptor after applying the given Turn, which must be in
+   * PossibleTurns.
+   */
+  [[nodiscard]] Uint apply(const Uint& descriptor, const Turn& turn) const {
+    const uint8_t turn_index = TurnIndices<PossibleTurns>[getTurnTableIndex(
+        turn)];
+    assert(turn_index != PossibleTurns.size());
+    return (*this)(descriptor, turn_index);
+  }
+};
+
+/**
+ * Applies Turns to descriptors of the form major * MinorCount + minor, where
+ * each Turn changes the major and the minor independently of each other, with
+ * a MoveTable for each. This needs MajorCount + MinorCount rows rather than
+ * one for every descriptor, e.g. for the E slice edge combination and corner
+ * orientation of domino reduction.
+ */
+template <auto MajorCount, auto MinorCount, auto PossibleTurns,
+          auto applyMajorTurn, auto applyMinorTurn>
+class ProductMoveTable {
+ public:
+  using Uint = std::common_type_t<decltype(MajorCount), decltype(MinorCount)>;
+  using MajorMoveTable = MoveTable<MajorCount, PossibleTurns, applyMajorTurn>;
+  using MinorMoveTable = MoveTable<MinorCount, PossibleTurns, applyMinorTurn>;
+
+ private:
+  MajorMoveTable major_move_table;
+  MinorMoveTable minor_move_table;
+
+ public:
+  ProductMoveTable() = default;
+
+  /**
+   * Shares the given MoveTables, e.g. between products with a coordinate in
+   * common.
+   */
+  ProductMoveTable(const MajorMoveTable& major_move_table,
+                   const MinorMoveTable& minor_move_table)
+      : major_move_table(major_move_table),
+        minor_move_table(minor_move_table) {}
+
+  /**
+   * @return The descriptor after applying PossibleTurns[turn_index].
+   */
+  [[nodiscard]] Uint operator()(const Uint& descriptor,
+                                const uint8_t& turn_index) const {
+    return static_cast<Uint>(
+        major_move_table(descriptor / MinorCount, turn_index) * MinorCount +
+        minor_move_table(descriptor % MinorCount, turn_index));
+  }
+
+  /**
+   * @return The descriptor after applying the given Turn, which must be in
+   * PossibleTurns.
+   */
+  [[nodiscard]] Uint apply(const Uint& descriptor, const Turn& turn) const {
+    const uint8_t turn_index = TurnIndices<PossibleTurns>[getTurnTableIndex(
+        turn)];
+    assert(turn_index != PossibleTurns.size());
+    return (*this)(descriptor, turn_index);
+  }
+};
+
 namespace detail {
 /**
  * Checks whether the provided template parameters form a syntactically valid
@@ -259,11 +364,110 @@ static constexpr auto getOptimalMoves() {
   return optimal_moves;
 }
 
+/**
+ * Equivalent to getOptimalMoves, but expands each layer of the BFS on
+ * thread_count threads. Each thread processes a contiguous chunk of the
+ * current frontier, and claims the descriptors it discovers by atomically
+ * lowering their priority, where the priority of reaching a descriptor is its
+ * parent's position in the frontier followed by the index of the Turn. The
+ * lowest priority is exactly the one that the serial BFS would have seen
+ * first, so after sorting the newly discovered descriptors by priority, both
+ * the resulting table and the next frontier are identical to the serial ones.
+ */
 template <auto DescriptorCount, auto PossibleTurns, auto applyTurn,
-          auto SolvedDescriptor, bool use_heap>
+          auto SolvedDescriptor>
   requires is_cubing_group_v<DescriptorCount, PossibleTurns, applyTurn,
                              SolvedDescriptor>
-constexpr auto getCompressedOptimalMoves() {
+auto getOptimalMovesParallel(
+    const size_t& thread_count = std::thread::hardware_concurrency()) {
+  using Uint = decltype(DescriptorCount);
+
+  static constexpr Uint UnknownSentinel = DescriptorCount;
+  static constexpr uint64_t Unclaimed = std::numeric_limits<uint64_t>::max();
+
+  utility::HeapArray<std::pair<Turn, Uint>, DescriptorCount> optimal_moves{};
+  for (size_t i = 0; i < DescriptorCount; ++i)
+    optimal_moves[i].second = UnknownSentinel;
+
+  const std::unique_ptr<std::atomic<uint64_t>[]> priorities{
+      new std::atomic<uint64_t>[DescriptorCount]};
+  for (size_t i = 0; i < DescriptorCount; ++i)
+    priorities[i].store(Unclaimed, std::memory_order_relaxed);
+
+  const size_t chunk_count = std::max(thread_count, size_t{1});
+  std::vector<std::vector<Uint>> discovered(chunk_count);
+  std::vector<Uint> frontier{SolvedDescriptor};
+  while (!frontier.empty()) {
+    const auto expand_chunk = [&](const size_t& chunk) {
+      const size_t begin = frontier.size() * chunk / chunk_count;
+      const size_t end = frontier.size() * (chunk + 1) / chunk_count;
+      for (size_t position = begin; position < end; ++position) {
+        for (size_t i = 0; i < PossibleTurns.size(); ++i) {
+          const Uint next_idx = applyTurn(frontier[position], PossibleTurns[i]);
+          // optimal_moves is only written between layers
+          if (next_idx == SolvedDescriptor ||
+              optimal_moves[next_idx].second != UnknownSentinel)
+            continue;
+          const uint64_t priority = position * PossibleTurns.size() + i;
+          uint64_t current =
+              priorities[next_idx].load(std::memory_order_relaxed);
+          while (priority < current &&
+                 !priorities[next_idx].compare_exchange_weak(
+                     current, priority, std::memory_order_relaxed)) {
+          }
+          // only the first claim records the descriptor, so it is discovered
+          // exactly once across all chunks
+          if (current == Unclaimed) discovered[chunk].push_back(next_idx);
+        }
+      }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(chunk_count - 1);
+    for (size_t chunk = 1; chunk < chunk_count; ++chunk)
+      threads.emplace_back(expand_chunk, chunk);
+    expand_chunk(0);
+    for (std::thread& thread : threads) thread.join();
+
+    std::vector<Uint> next_frontier;
+    for (std::vector<Uint>& chunk : discovered) {
+      next_frontier.insert(next_frontier.end(), chunk.begin(), chunk.end());
+      chunk.clear();
+    }
+    std::sort(next_frontier.begin(), next_frontier.end(),
+              [&](const Uint& first, const Uint& second) {
+                return priorities[first].load(std::memory_order_relaxed) <
+                       priorities[second].load(std::memory_order_relaxed);
+              });
+    for (const Uint& idx : next_frontier) {
+      const uint64_t priority = priorities[idx].load(std::memory_order_relaxed);
+      optimal_moves[idx].first =
+          PossibleTurns[priority % PossibleTurns.size()].inv();
+      optimal_moves[idx].second = frontier[priority / PossibleTurns.size()];
+    }
+    frontier = std::move(next_frontier);
+  }
+  assert(optimal_moves[SolvedDescriptor].second == UnknownSentinel);
+  assert([&]() {
+    for (size_t i = 0; i < optimal_moves.size(); ++i) {
+      if (i == SolvedDescriptor) continue;
+      if (optimal_moves[i].second == UnknownSentinel) return false;
+    }
+    return true;
+  }());
+  return optimal_moves;
+}
+
+/**
+ * Packs the given optimal moves into a PackedBitsArray where each element is
+ * the index of the optimal Turn in PossibleTurns followed by the descriptor
+ * that it leads to.
+ */
+template <auto DescriptorCount, auto PossibleTurns, auto applyTurn,
+          auto SolvedDescriptor, bool use_heap, typename OptimalMoves>
+  requires is_cubing_group_v<DescriptorCount, PossibleTurns, applyTurn,
+                             SolvedDescriptor>
+constexpr auto compressOptimalMoves(const OptimalMoves& optimal_moves) {
   using Uint = decltype(DescriptorCount);
   /** static **/ constexpr uint8_t DescriptorBits =
       utility::requiredBits(DescriptorCount);
@@ -271,10 +475,6 @@ constexpr auto getCompressedOptimalMoves() {
       utility::requiredBits(PossibleTurns.size());
   /** static **/ constexpr uint8_t CompressedBits = DescriptorBits + TurnBits;
 
-  const auto optimal_moves =
-      detail::getOptimalMoves<DescriptorCount, PossibleTurns, applyTurn,
-                              SolvedDescriptor, use_heap>();
-
   utility::PackedBitsArray<CompressedBits, DescriptorCount, use_heap>
       compressed_optimal_moves;
   /**
@@ -301,12 +501,159 @@ constexpr auto getCompressedOptimalMoves() {
 
   return compressed_optimal_moves;
 }
+
+template <auto DescriptorCount, auto PossibleTurns, auto applyTurn,
+          auto SolvedDescriptor, bool use_heap>
+  requires is_cubing_group_v<DescriptorCount, PossibleTurns, applyTurn,
+                             SolvedDescriptor>
+constexpr auto getCompressedOptimalMoves() {
+  return compressOptimalMoves<DescriptorCount, PossibleTurns, applyTurn,
+                              SolvedDescriptor, use_heap>(
+      getOptimalMoves<DescriptorCount, PossibleTurns, applyTurn,
+                      SolvedDescriptor, use_heap>());
+}
+
+template <auto DescriptorCount, auto PossibleTurns, auto applyTurn,
+          auto SolvedDescriptor>
+  requires is_cubing_group_v<DescriptorCount, PossibleTurns, applyTurn,
+                             SolvedDescriptor>
+auto getCompressedOptimalMovesParallel(
+    const size_t& thread_count = std::thread::hardware_concurrency()) {
+  return compressOptimalMoves<DescriptorCount, PossibleTurns, applyTurn,
+                              SolvedDescriptor, true>(
+      getOptimalMovesParallel<DescriptorCount, PossibleTurns, applyTurn,
+                              SolvedDescriptor>(thread_count));
+}
+
+/**
+ * The value of pruning table entries whose distance has not been found yet.
+ * Every entry of a complete pruning table is instead its distance mod 3.
+ */
+static constexpr uint8_t UnknownPruningValue = 3;
+
+/**
+ * Generates a table of the distance (mod 3) of every descriptor from
+ * SolvedDescriptor, using 2 bits per descriptor instead of the
+ * DescriptorBits + TurnBits of getCompressedOptimalMoves.
+ *
+ * Instead of keeping a frontier, each layer of the BFS expands every
+ * descriptor whose value matches the current depth mod 3. This also re-expands
+ * descriptors 3, 6, ... moves shallower, but all of their neighbours have
+ * already been found, so this only costs time and no memory.
+ */
+template <auto DescriptorCount, auto PossibleTurns, auto applyTurn,
+          auto SolvedDescriptor, bool use_heap>
+  requires is_cubing_group_v<DescriptorCount, PossibleTurns, applyTurn,
+                             SolvedDescriptor>
+constexpr auto getPruningTable() {
+  using Uint = decltype(DescriptorCount);
+
+  utility::PackedBitsArray<2, DescriptorCount, use_heap> pruning_table{};
+  // checking this first also makes GCC give up straight away when it
+  // speculatively constant-evaluates a call made at runtime, rather than after
+  // running the BFS up to the first call of a non-constexpr applyTurn
+  if (std::is_constant_evaluated()) {
+    for (size_t i = 0; i < DescriptorCount; ++i)
+      pruning_table[i] = UnknownPruningValue;
+  } else {
+    // every 2 bit entry becomes 0b11 == UnknownPruningValue
+    std::fill_n(pruning_table.rawData().data(), pruning_table.rawData().size(),
+                0xFF);
+  }
+  pruning_table[SolvedDescriptor] = 0;
+
+  bool found_descriptor = true;
+  for (uint8_t depth = 0; found_descriptor; depth = (depth + 1) % 3) {
+    found_descriptor = false;
+    const uint8_t next_depth = (depth + 1) % 3;
+    for (size_t idx = 0; idx < DescriptorCount; ++idx) {
+      if (pruning_table[idx] != depth) continue;
+      for (const Turn& turn : PossibleTurns) {
+        const Uint next_idx = applyTurn(static_cast<Uint>(idx), turn);
+        if (pruning_table[next_idx] == UnknownPruningValue) {
+          pruning_table[next_idx] = next_depth;
+          found_descriptor = true;
+        }
+      }
+    }
+  }
+  assert([&]() {
+    for (size_t i = 0; i < DescriptorCount; ++i)
+      if (pruning_table[i] == UnknownPruningValue) return false;
+    return true;
+  }());
+  return pruning_table;
+}
 }  // namespace detail
 
+/**
+ * @return The number of bits in each element of the compressed lookup table
+ * for the given group.
+ */
+template <auto DescriptorCount, auto PossibleTurns>
+consteval uint8_t getCompressedBits() {
+  return utility::requiredBits(DescriptorCount) +
+         utility::requiredBits(PossibleTurns.size());
+}
+
+/**
+ * @brief Follows the optimal moves in the given compressed lookup table (e.g.
+ * a PackedBitsArray or PackedBitsArrayView of the output of
+ * getCompressedOptimalMoves) from the given descriptor to SolvedDescriptor.
+ */
+template <auto DescriptorCount, auto PossibleTurns, auto SolvedDescriptor,
+          typename LookupTable>
+constexpr Algorithm solveWithLookupTable(
+    const LookupTable& lookup_table, decltype(DescriptorCount) descriptor) {
+  /** static **/ constexpr uint8_t DescriptorBits =
+      utility::requiredBits(DescriptorCount);
+
+  Algorithm alg;
+  while (descriptor != SolvedDescriptor) {
+    const auto compressed_optimal_move = lookup_table[descriptor];
+    alg.push_back(
+        Move{PossibleTurns[compressed_optimal_move >> DescriptorBits]});
+    descriptor = compressed_optimal_move % (1 << DescriptorBits);
+  }
+  return alg;
+}
+
+/**
+ * @brief Searches for an optimal solve of the given descriptor using a table
+ * generated by getPruningTable (or a PackedBitsArrayView of one).
+ *
+ * This is IDA* where the heuristic is the distance stored in the table. Since
+ * that distance is exact, the first iteration never needs to backtrack: of the
+ * neighbours of a descriptor at distance d, one is always at distance d - 1,
+ * which is the only neighbour whose value is (d - 1) mod 3 (the others being
+ * at distances d and d + 1). The search therefore reduces to repeatedly
+ * testing neighbours until one is found that is a move closer to solved.
+ */
+template <auto DescriptorCount, auto PossibleTurns, auto applyTurn,
+          auto SolvedDescriptor, typename PruningTable>
+  requires detail::is_cubing_group_v<DescriptorCount, PossibleTurns, applyTurn,
+                                     SolvedDescriptor>
+constexpr Algorithm solveWithPruningTable(
+    const PruningTable& pruning_table, decltype(DescriptorCount) descriptor) {
+  Algorithm alg;
+  while (descriptor != SolvedDescriptor) {
+    assert(pruning_table[descriptor] != detail::UnknownPruningValue);
+    const uint8_t closer_depth = (pruning_table[descriptor] + 2) % 3;
+    const auto closer_turn = std::find_if(
+        PossibleTurns.begin(), PossibleTurns.end(), [&](const Turn& turn) {
+          return pruning_table[applyTurn(descriptor, turn)] == closer_depth;
+        });
+    assert(closer_turn != PossibleTurns.end());
+    alg.push_back(Move{*closer_turn});
+    descriptor = applyTurn(descriptor, *closer_turn);
+  }
+  return alg;
+}
+
 /**
  * If this crashes during compilation due to a lack of memory, use
- * generateLookupTable and embed the generated header file in the code
- * instead.
+ * getRuntimeSolver instead, or generateLookupTable and embed the generated
+ * header file in the code.
  */
 template <auto DescriptorCount, auto PossibleTurns, auto applyTurn,
           auto SolvedDescriptor = 0>
@@ -314,21 +661,13 @@ template <auto DescriptorCount, auto PossibleTurns, auto applyTurn,
                                      SolvedDescriptor>
 consteval auto getSolver() {
   using Uint = decltype(DescriptorCount);
-  return [](Uint descriptor) {
-    static constexpr uint8_t DescriptorBits =
-        utility::requiredBits(DescriptorCount);
+  return [](const Uint& descriptor) {
     static constexpr auto CompressedOptimalMoves =
         detail::getCompressedOptimalMoves<DescriptorCount, PossibleTurns,
                                           applyTurn, SolvedDescriptor, false>();
-
-    Algorithm alg;
-    while (descriptor != SolvedDescriptor) {
-      const auto compressed_optimal_move = CompressedOptimalMoves[descriptor];
-      alg.push_back(
-          Move{PossibleTurns[compressed_optimal_move >> DescriptorBits]});
-      descriptor = compressed_optimal_move % (1 << DescriptorBits);
-    }
-    return alg;
+    return solveWithLookupTable<DescriptorCount, PossibleTurns,
+                                SolvedDescriptor>(CompressedOptimalMoves,
+                                                  descriptor);
   };
 }
 
@@ -338,11 +677,220 @@ template <auto DescriptorCount, auto PossibleTurns, auto applyTurn,
                                      SolvedDescriptor>
 auto generateLookupTable(const std::string& file_name) {
   const auto compressed_optimal_moves =
-      detail::getCompressedOptimalMoves<DescriptorCount, PossibleTurns,
-                                        applyTurn, SolvedDescriptor, true>();
+      detail::getCompressedOptimalMovesParallel<DescriptorCount, PossibleTurns,
+                                                applyTurn, SolvedDescriptor>();
 
   std::ofstream data_table_file{file_name};
   for (const uint8_t& element : compressed_optimal_moves.rawData())
     data_table_file << std::to_string(element) << ',';
 }
+
+/**
+ * The kinds of table files that can be written for the same group.
+ */
+enum class TableKind : uint8_t { Lookup, Pruning, ReducedPruning };
+
+/**
+ * @return An identity for the tables of the given kind for the given group,
+ * stored in their files so that a file written for a different group of the
+ * same shape (e.g. one with an older descriptor) is not mapped. It hashes the
+ * solved descriptor and the result of applying every Turn to a sample of
+ * descriptors, so changing the descriptor almost certainly changes it.
+ */
+template <auto DescriptorCount, auto PossibleTurns, auto applyTurn,
+          auto SolvedDescriptor = 0>
+uint64_t getTableId(const TableKind& kind, const uint64_t& salt = 0) {
+  using Uint = decltype(DescriptorCount);
+  static constexpr uint64_t SampleCount = 64;
+
+  std::vector<uint64_t> values{static_cast<uint64_t>(kind), salt,
+                               static_cast<uint64_t>(DescriptorCount),
+                               static_cast<uint64_t>(SolvedDescriptor)};
+  for (uint64_t i = 0; i < SampleCount; ++i) {
+    const auto descriptor = static_cast<Uint>(
+        static_cast<uint64_t>(DescriptorCount) * i / SampleCount);
+    for (const Turn& turn : PossibleTurns)
+      values.push_back(applyTurn(descriptor, turn));
+  }
+  return utility::getLookupTableChecksum(
+      reinterpret_cast<const uint8_t*>(values.data()),
+      values.size() * sizeof(uint64_t));
+}
+
+/**
+ * @brief Generates the compressed lookup table for the given group and writes
+ * it to the given file in the binary format of utility::LookupTableHeader, to
+ * be loaded at runtime with mapLookupTable.
+ */
+template <auto DescriptorCount, auto PossibleTurns, auto applyTurn,
+          auto SolvedDescriptor = 0>
+  requires detail::is_cubing_group_v<DescriptorCount, PossibleTurns, applyTurn,
+                                     SolvedDescriptor>
+void generateLookupTableFile(const std::string& file_name) {
+  const auto compressed_optimal_moves =
+      detail::getCompressedOptimalMovesParallel<DescriptorCount, PossibleTurns,
+                                                applyTurn, SolvedDescriptor>();
+  utility::writeLookupTableFile(
+      file_name, getCompressedBits<DescriptorCount, PossibleTurns>(),
+      DescriptorCount,
+      getTableId<DescriptorCount, PossibleTurns, applyTurn, SolvedDescriptor>(
+          TableKind::Lookup),
+      compressed_optimal_moves.rawData().data(),
+      compressed_optimal_moves.rawData().size());
+}
+
+/**
+ * @brief Maps a lookup table written by generateLookupTableFile, checking that
+ * it has the shape and table id expected for the given group. The table can
+ * then be read through a PackedBitsArrayView of its data and passed to
+ * solveWithLookupTable.
+ * @return std::nullopt if the file does not exist.
+ * @throws std::runtime_error If the file is not a valid lookup table for the
+ * given group.
+ */
+template <auto DescriptorCount, auto PossibleTurns, auto applyTurn,
+          auto SolvedDescriptor = 0>
+std::optional<utility::MappedLookupTable> mapLookupTable(
+    const std::string& file_name) {
+  return utility::MappedLookupTable::open(
+      file_name, getCompressedBits<DescriptorCount, PossibleTurns>(),
+      DescriptorCount,
+      getTableId<DescriptorCount, PossibleTurns, applyTurn, SolvedDescriptor>(
+          TableKind::Lookup));
+}
+
+/**
+ * A compressed lookup table that is built at runtime rather than at compile
+ * time, and cached in a binary file so that later runs only need to map it.
+ * This is the alternative to getSolver for groups whose tables are too large
+ * to evaluate at compile time.
+ */
+template <auto DescriptorCount, auto PossibleTurns, auto applyTurn,
+          auto SolvedDescriptor = 0>
+  requires detail::is_cubing_group_v<DescriptorCount, PossibleTurns, applyTurn,
+                                     SolvedDescriptor>
+class RuntimeLookupTable {
+ public:
+  using Uint = decltype(DescriptorCount);
+  static constexpr uint8_t CompressedBits =
+      getCompressedBits<DescriptorCount, PossibleTurns>();
+
+ private:
+  using GeneratedTable =
+      utility::PackedBitsArray<CompressedBits, DescriptorCount, true>;
+
+  std::optional<utility::MappedLookupTable> mapped_table;
+  std::optional<GeneratedTable> generated_table;
+
+ public:
+  /**
+   * @brief Maps the table cached in cache_file_name. If the file does not
+   * exist or is not a valid table for this group (e.g. because it is corrupt,
+   * or its table id shows that it was written for an older descriptor), the
+   * table is generated instead and written to the file. If that fails, the
+   * generated table is used from memory.
+   */
+  explicit RuntimeLookupTable(const std::string& cache_file_name) {
+    try {
+      mapped_table =
+          mapLookupTable<DescriptorCount, PossibleTurns, applyTurn,
+                         SolvedDescriptor>(cache_file_name);
+    } catch (const std::runtime_error&) {
+      // an invalid cache is regenerated and overwritten below
+    }
+    if (mapped_table) return;
+
+    generated_table.emplace(
+        detail::getCompressedOptimalMovesParallel<
+            DescriptorCount, PossibleTurns, applyTurn, SolvedDescriptor>());
+    try {
+      utility::writeLookupTableFile(
+          cache_file_name, CompressedBits, DescriptorCount,
+          getTableId<DescriptorCount, PossibleTurns, applyTurn,
+                     SolvedDescriptor>(TableKind::Lookup),
+          generated_table->rawData().data(), generated_table->rawData().size());
+    } catch (const std::exception&) {
+      // the generated table still works, it just has to be regenerated by the
+      // next process
+    }
+  }
+
+  /**
+   * @return Whether the table was generated rather than mapped from its cache.
+   */
+  [[nodiscard]] bool wasGenerated() const {
+    return generated_table.has_value();
+  }
+
+  [[nodiscard]] const uint8_t* data() const {
+    return mapped_table ? mapped_table->data()
+                        : generated_table->rawData().data();
+  }
+
+  [[nodiscard]] Algorithm solve(const Uint& descriptor) const {
+    return solveWithLookupTable<DescriptorCount, PossibleTurns,
+                                SolvedDescriptor>(
+        utility::PackedBitsArrayView<CompressedBits, DescriptorCount>{data()},
+        descriptor);
+  }
+};
+
+/**
+ * The runtime counterpart of getSolver: instead of the table being evaluated
+ * during compilation, a RuntimeLookupTable cached in cache_file_name is built
+ * (or mapped) here and owned by the returned solver, so solvers for different
+ * files never share a table. Store the solver in a function-local static to
+ * defer this to the first solve.
+ */
+template <auto DescriptorCount, auto PossibleTurns, auto applyTurn,
+          auto SolvedDescriptor = 0>
+  requires detail::is_cubing_group_v<DescriptorCount, PossibleTurns, applyTurn,
+                                     SolvedDescriptor>
+auto getRuntimeSolver(const char* const cache_file_name) {
+  using Uint = decltype(DescriptorCount);
+  using LookupTable = RuntimeLookupTable<DescriptorCount, PossibleTurns,
+                                         applyTurn, SolvedDescriptor>;
+  return [lookup_table = std::make_shared<const LookupTable>(cache_file_name)](
+             const Uint& descriptor) {
+    return lookup_table->solve(descriptor);
+  };
+}
+
+/**
+ * @brief Generates the pruning table for the given group and writes it to the
+ * given file in the binary format of utility::LookupTableHeader, to be loaded
+ * at runtime with mapPruningTable.
+ */
+template <auto DescriptorCount, auto PossibleTurns, auto applyTurn,
+          auto SolvedDescriptor = 0>
+  requires detail::is_cubing_group_v<DescriptorCount, PossibleTurns, applyTurn,
+                                     SolvedDescriptor>
+void generatePruningTableFile(const std::string& file_name) {
+  const auto pruning_table =
+      detail::getPruningTable<DescriptorCount, PossibleTurns, applyTurn,
+                              SolvedDescriptor, true>();
+  utility::writeLookupTableFile(
+      file_name, 2, DescriptorCount,
+      getTableId<DescriptorCount, PossibleTurns, applyTurn, SolvedDescriptor>(
+          TableKind::Pruning),
+      pruning_table.rawData().data(), pruning_table.rawData().size());
+}
+
+/**
+ * @brief Maps a pruning table written by generatePruningTableFile, which can
+ * then be read through a PackedBitsArrayView of its data and passed to
+ * solveWithPruningTable.
+ * @return std::nullopt if the file does not exist.
+ * @throws std::runtime_error If the file is not a valid pruning table for the
+ * given group.
+ */
+template <auto DescriptorCount, auto PossibleTurns, auto applyTurn,
+          auto SolvedDescriptor = 0>
+std::optional<utility::MappedLookupTable> mapPruningTable(
+    const std::string& file_name) {
+  return utility::MappedLookupTable::open(
+      file_name, 2, DescriptorCount,
+      getTableId<DescriptorCount, PossibleTurns, applyTurn, SolvedDescriptor>(
+          TableKind::Pruning));
+}
 }  // namespace solvers
@@ -0,0 +1,441 @@
+#pragma once
+
+#include "Algorithm.h"
+#include "CubeOrientation.h"
+#include "Face.h"
+#include "HeapArray.h"
+#include "LookupTableFile.h"
+#include "PackedBitsArray.h"
+#include "SolverUtils.h"
+#include "Turn.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace solvers {
+namespace detail {
+template <Face... AxisFaces>
+constexpr bool preservesAxes(const CubeOrientation& orientation) {
+  return ((orientation.apply(AxisFaces) == AxisFaces ||
+           orientation.apply(AxisFaces) == getOpposite(AxisFaces)) &&
+          ...);
+}
+
+template <Face... AxisFaces>
+consteval size_t getAxisSymmetryCount() {
+  using enum Face;
+  size_t count = 0;
+  for (const Face& top : {U, F, R, B, L, D})
+    for (const Face& front : {U, F, R, B, L, D})
+      if (const CubeOrientation orientation{top, front};
+          orientation.isValid() && preservesAxes<AxisFaces...>(orientation))
+        ++count;
+  return count;
+}
+}  // namespace detail
+
+/**
+ * @return The rotations of the Cube that keep each of the axes through the
+ * given Faces in place, possibly reversing them, starting with the identity.
+ * These are the symmetries of a group whose turns treat those axes
+ * differently from the others, e.g. {Face::F} for edge orientation, where F
+ * and B quarter turns are restricted.
+ */
+template <Face... AxisFaces>
+consteval auto getAxisSymmetries() {
+  using enum Face;
+  std::array<CubeOrientation, detail::getAxisSymmetryCount<AxisFaces...>()>
+      symmetries;
+  size_t i = 0;
+  for (const Face& top : {U, F, R, B, L, D})
+    for (const Face& front : {U, F, R, B, L, D})
+      if (const CubeOrientation orientation{top, front};
+          orientation.isValid() &&
+          detail::preservesAxes<AxisFaces...>(orientation))
+        symmetries[i++] = orientation;
+  assert(i == symmetries.size());
+  assert(symmetries.front() == CubeOrientation::identity());
+  return symmetries;
+}
+
+namespace detail {
+/**
+ * @return An array where the element at [s][i] is the index in PossibleTurns
+ * of PossibleTurns[i] conjugated by Symmetries[s].
+ */
+template <auto PossibleTurns, auto Symmetries>
+consteval auto getSymmetricTurnIndices() {
+  std::array<std::array<uint8_t, PossibleTurns.size()>, Symmetries.size()>
+      symmetric_turn_indices{};
+  for (size_t s = 0; s < Symmetries.size(); ++s) {
+    for (size_t i = 0; i < PossibleTurns.size(); ++i) {
+      const Turn symmetric_turn = Symmetries[s].apply(PossibleTurns[i]);
+      const size_t index =
+          std::find(PossibleTurns.begin(), PossibleTurns.end(),
+                    symmetric_turn) -
+          PossibleTurns.begin();
+      if (index == PossibleTurns.size())
+        throw std::logic_error("The symmetries do not preserve the turns!");
+      symmetric_turn_indices[s][i] = index;
+    }
+  }
+  return symmetric_turn_indices;
+}
+
+/**
+ * Computes the conjugates of every coordinate by every symmetry, where the
+ * element at [c][s] is coordinate c conjugated by Symmetries[s].
+ *
+ * Rather than needing to know what each coordinate means, this conjugates a
+ * path of turns from the solved coordinate to each coordinate, which leads to
+ * its conjugate. This is only well defined if the coordinates are preserved by
+ * the symmetries, which checkConjugates verifies.
+ */
+template <auto Count, auto PossibleTurns, auto Symmetries, bool use_heap,
+          typename ApplyTurn>
+constexpr auto getConjugates(const decltype(Count)& solved,
+                             const ApplyTurn& apply_turn) {
+  using Uint = decltype(Count);
+  /** static **/ constexpr auto SymmetricTurnIndices =
+      getSymmetricTurnIndices<PossibleTurns, Symmetries>();
+  /** static **/ constexpr Uint UnknownSentinel = Count;
+
+  utility::pick_array_t<std::array<Uint, Symmetries.size()>, Count, use_heap>
+      conjugates{};
+  for (size_t i = 0; i < Count; ++i) conjugates[i].fill(UnknownSentinel);
+  conjugates[solved].fill(solved);
+
+  // every coordinate is queued once, in the order of a BFS from solved
+  utility::pick_array_t<Uint, Count, use_heap> queue{};
+  queue[0] = solved;
+  size_t queue_size = 1;
+  for (size_t position = 0; position < queue_size; ++position) {
+    const Uint idx = queue[position];
+    for (size_t i = 0; i < PossibleTurns.size(); ++i) {
+      const Uint next_idx = apply_turn(idx, PossibleTurns[i]);
+      if (conjugates[next_idx].front() != UnknownSentinel) continue;
+      for (size_t s = 0; s < Symmetries.size(); ++s)
+        conjugates[next_idx][s] = apply_turn(
+            conjugates[idx][s], PossibleTurns[SymmetricTurnIndices[s][i]]);
+      queue[queue_size++] = next_idx;
+    }
+  }
+  if (queue_size != Count)
+    throw std::logic_error("Not every coordinate can be reached!");
+  return conjugates;
+}
+
+/**
+ * @brief Checks that conjugating any coordinate and then applying a conjugated
+ * turn is the same as conjugating the result of the original turn.
+ * @throws std::logic_error If the coordinates are not preserved by the
+ * symmetries, so that the output of getConjugates is meaningless.
+ */
+template <auto Count, auto PossibleTurns, auto Symmetries,
+          typename Conjugates, typename ApplyTurn>
+void checkConjugates(const Conjugates& conjugates,
+                     const ApplyTurn& apply_turn) {
+  using Uint = decltype(Count);
+  static constexpr auto SymmetricTurnIndices =
+      getSymmetricTurnIndices<PossibleTurns, Symmetries>();
+
+  for (size_t idx = 0; idx < Count; ++idx) {
+    for (size_t i = 0; i < PossibleTurns.size(); ++i) {
+      const Uint next_idx =
+          apply_turn(static_cast<Uint>(idx), PossibleTurns[i]);
+      for (size_t s = 0; s < Symmetries.size(); ++s)
+        if (conjugates[next_idx][s] !=
+            apply_turn(conjugates[idx][s],
+                       PossibleTurns[SymmetricTurnIndices[s][i]]))
+          throw std::logic_error(
+              "The coordinates are not preserved by the symmetries!");
+    }
+  }
+}
+
+/**
+ * The representative of each class of conjugate coordinates is the smallest
+ * coordinate in the class, so the coordinates that are representatives are
+ * exactly those that are no larger than any of their conjugates.
+ */
+template <typename Conjugates>
+constexpr bool isRepresentative(const Conjugates& conjugates,
+                                const size_t& idx) {
+  return *std::min_element(conjugates[idx].begin(), conjugates[idx].end()) ==
+         idx;
+}
+
+template <auto Count, auto PossibleTurns, auto Symmetries>
+consteval size_t getSymmetryClassCount(const decltype(Count)& solved,
+                                       const auto& apply_turn) {
+  const auto conjugates =
+      getConjugates<Count, PossibleTurns, Symmetries, false>(solved,
+                                                             apply_turn);
+  size_t class_count = 0;
+  for (size_t idx = 0; idx < Count; ++idx)
+    if (isRepresentative(conjugates, idx)) ++class_count;
+  return class_count;
+}
+
+template <auto MinorCount, auto applyTurn, auto SolvedDescriptor>
+constexpr auto applyMajorTurn(const decltype(SolvedDescriptor)& major,
+                              const Turn& turn) {
+  return static_cast<decltype(SolvedDescriptor)>(
+      applyTurn(major * MinorCount + SolvedDescriptor % MinorCount, turn) /
+      MinorCount);
+}
+
+template <auto MinorCount, auto applyTurn, auto SolvedDescriptor>
+constexpr auto applyMinorTurn(const decltype(SolvedDescriptor)& minor,
+                              const Turn& turn) {
+  return static_cast<decltype(SolvedDescriptor)>(
+      applyTurn(SolvedDescriptor / MinorCount * MinorCount + minor, turn) %
+      MinorCount);
+}
+}  // namespace detail
+
+/**
+ * Reduces the descriptors of a group by the given symmetries (e.g. from
+ * getAxisSymmetries), since conjugate descriptors are the same number of moves
+ * from SolvedDescriptor and so can share a pruning table entry.
+ *
+ * Each descriptor is split into major * MinorCount + minor, where applyTurn
+ * must change the major and the minor independently of each other, like the E
+ * slice edge combination and corner orientation of domino reduction. The
+ * majors are grouped into classes of conjugates, and a descriptor is reduced
+ * to the representative of its major's class together with its minor
+ * conjugated by the same symmetry (the smallest such conjugate, if several
+ * symmetries lead to the representative). This leaves ClassCount * MinorCount
+ * reduced descriptors, roughly Symmetries.size() times fewer than
+ * DescriptorCount.
+ * Passing a MinorCount of 1 reduces whole descriptors instead.
+ */
+template <auto DescriptorCount, auto MinorCount, auto PossibleTurns,
+          auto applyTurn, auto SolvedDescriptor, auto Symmetries>
+  requires detail::is_cubing_group_v<DescriptorCount, PossibleTurns, applyTurn,
+                                     SolvedDescriptor> &&
+           (MinorCount > 0 && DescriptorCount % MinorCount == 0)
+class SymmetryReduction {
+ public:
+  using Uint = decltype(DescriptorCount);
+  static constexpr Uint MajorCount = DescriptorCount / MinorCount;
+  static constexpr Uint SymmetryCount = Symmetries.size();
+  static_assert(SymmetryCount <= 32);
+  static constexpr Uint ClassCount =
+      detail::getSymmetryClassCount<MajorCount, PossibleTurns, Symmetries>(
+          SolvedDescriptor / MinorCount,
+          detail::applyMajorTurn<MinorCount, applyTurn, SolvedDescriptor>);
+  static constexpr Uint ReducedCount = ClassCount * MinorCount;
+
+ private:
+  utility::HeapArray<std::array<Uint, SymmetryCount>, MinorCount>
+      minor_conjugates;
+  // the class of each major and a mask of the symmetries that conjugate it to
+  // the representative of that class
+  utility::HeapArray<std::pair<Uint, uint32_t>, MajorCount> major_classes;
+  utility::HeapArray<Uint, ClassCount> representatives;
+  ProductMoveTable<MajorCount, static_cast<Uint>(MinorCount), PossibleTurns,
+                   detail::applyMajorTurn<MinorCount, applyTurn,
+                                          SolvedDescriptor>,
+                   detail::applyMinorTurn<MinorCount, applyTurn,
+                                          SolvedDescriptor>>
+      move_table;
+
+ public:
+  /**
+   * Builds the conjugation and move tables at runtime, which are a small
+   * fraction of the size of a pruning table.
+   * @throws std::logic_error If the descriptors are not preserved by the
+   * symmetries.
+   */
+  SymmetryReduction()
+      : minor_conjugates(
+            detail::getConjugates<static_cast<Uint>(MinorCount),
+                                  PossibleTurns, Symmetries, true>(
+                SolvedDescriptor % MinorCount,
+                detail::applyMinorTurn<MinorCount, applyTurn,
+                                       SolvedDescriptor>)) {
+    detail::checkConjugates<static_cast<Uint>(MinorCount), PossibleTurns,
+                            Symmetries>(
+        minor_conjugates,
+        detail::applyMinorTurn<MinorCount, applyTurn, SolvedDescriptor>);
+    const auto major_conjugates =
+        detail::getConjugates<MajorCount, PossibleTurns, Symmetries, true>(
+            SolvedDescriptor / MinorCount,
+            detail::applyMajorTurn<MinorCount, applyTurn, SolvedDescriptor>);
+    detail::checkConjugates<MajorCount, PossibleTurns, Symmetries>(
+        major_conjugates,
+        detail::applyMajorTurn<MinorCount, applyTurn, SolvedDescriptor>);
+
+    // representatives are the smallest in their class, so they are always
+    // reached before the rest of their class
+    Uint class_count = 0;
+    for (size_t major = 0; major < MajorCount; ++major) {
+      const auto& conjugates = major_conjugates[major];
+      const Uint representative =
+          *std::min_element(conjugates.begin(), conjugates.end());
+      if (representative == major) representatives[class_count++] = major;
+      uint32_t symmetries = 0;
+      for (size_t s = 0; s < SymmetryCount; ++s)
+        if (conjugates[s] == representative) symmetries |= 1u << s;
+      major_classes[major] = {representative == major
+                                  ? class_count - 1
+                                  : major_classes[representative].first,
+                              symmetries};
+    }
+    assert(class_count == ClassCount);
+  }
+
+  /**
+   * @return The index of the given descriptor in a table with an entry for
+   * each of the ReducedCount reduced descriptors.
+   */
+  [[nodiscard]] size_t reduce(const Uint& descriptor) const {
+    const auto& [symmetry_class, symmetries] =
+        major_classes[descriptor / MinorCount];
+    const auto& conjugates = minor_conjugates[descriptor % MinorCount];
+    // a representative with symmetries of its own is reached by more than one
+    // symmetry, which conjugate the minor differently, so the smallest is used
+    // to give every conjugate descriptor the same reduction
+    Uint minor = conjugates[std::countr_zero(symmetries)];
+    for (uint32_t mask = symmetries & (symmetries - 1); mask != 0;
+         mask &= mask - 1)
+      minor = std::min(minor, conjugates[std::countr_zero(mask)]);
+    return static_cast<size_t>(symmetry_class) * MinorCount + minor;
+  }
+
+  /**
+   * @return The descriptor represented by the given reduced index, which is a
+   * conjugate of every descriptor that reduces to it. Some reduced indices are
+   * never the reduction of a descriptor, in which case this reduces to a
+   * different index.
+   */
+  [[nodiscard]] Uint getRepresentative(const size_t& reduced) const {
+    return representatives[reduced / MinorCount] * MinorCount +
+           reduced % MinorCount;
+  }
+
+  /**
+   * Equivalent to detail::getPruningTable, but with an entry for each reduced
+   * descriptor, so the table is smaller and each layer of the BFS scans fewer
+   * entries.
+   */
+  [[nodiscard]] utility::PackedBitsArray<2, ReducedCount, true>
+  getPruningTable() const {
+    utility::PackedBitsArray<2, ReducedCount, true> pruning_table{};
+    // every 2 bit entry becomes 0b11 == UnknownPruningValue
+    std::fill_n(pruning_table.rawData().data(), pruning_table.rawData().size(),
+                0xFF);
+    pruning_table[reduce(SolvedDescriptor)] = 0;
+
+    bool found_descriptor = true;
+    for (uint8_t depth = 0; found_descriptor; depth = (depth + 1) % 3) {
+      found_descriptor = false;
+      const uint8_t next_depth = (depth + 1) % 3;
+      for (size_t idx = 0; idx < ReducedCount; ++idx) {
+        if (pruning_table[idx] != depth) continue;
+        const Uint descriptor = getRepresentative(idx);
+        for (uint8_t i = 0; i < PossibleTurns.size(); ++i) {
+          const size_t next_idx = reduce(move_table(descriptor, i));
+          if (pruning_table[next_idx] == detail::UnknownPruningValue) {
+            pruning_table[next_idx] = next_depth;
+            found_descriptor = true;
+          }
+        }
+      }
+    }
+    assert([&]() {
+      for (size_t i = 0; i < ReducedCount; ++i)
+        if (pruning_table[i] == detail::UnknownPruningValue &&
+            reduce(getRepresentative(i)) == i)
+          return false;
+      return true;
+    }());
+    return pruning_table;
+  }
+
+  /**
+   * @brief Equivalent to solveWithPruningTable, but looks up each descriptor
+   * in a table generated by getPruningTable (or a PackedBitsArrayView of one)
+   * by its reduced index.
+   */
+  template <typename PruningTable>
+  [[nodiscard]] Algorithm solve(const PruningTable& pruning_table,
+                                Uint descriptor) const {
+    Algorithm alg;
+    while (descriptor != SolvedDescriptor) {
+      assert(pruning_table[reduce(descriptor)] != detail::UnknownPruningValue);
+      const uint8_t closer_depth = (pruning_table[reduce(descriptor)] + 2) % 3;
+      uint8_t i = 0;
+      while (i < PossibleTurns.size() &&
+             pruning_table[reduce(move_table(descriptor, i))] != closer_depth)
+        ++i;
+      assert(i < PossibleTurns.size());
+      alg.push_back(Move{PossibleTurns[i]});
+      descriptor = move_table(descriptor, i);
+    }
+    return alg;
+  }
+
+  /**
+   * @brief Generates the reduced pruning table and writes it to the given file
+   * in the binary format of utility::LookupTableHeader.
+   */
+  void generatePruningTableFile(const std::string& file_name) const {
+    const auto pruning_table = getPruningTable();
+    utility::writeLookupTableFile(file_name, 2, ReducedCount, getTableId(),
+                                  pruning_table.rawData().data(),
+                                  pruning_table.rawData().size());
+  }
+
+  /**
+   * @brief Maps a reduced pruning table written by generatePruningTableFile.
+   * @return std::nullopt if the file does not exist.
+   * @throws std::runtime_error If the file is not a valid reduced pruning
+   * table for this group.
+   */
+  static std::optional<utility::MappedLookupTable> mapPruningTable(
+      const std::string& file_name) {
+    return utility::MappedLookupTable::open(file_name, 2, ReducedCount,
+                                            getTableId());
+  }
+
+ private:
+  /**
+   * The table id of the reduced pruning table, which also depends on the
+   * symmetries through the number of classes and the number of symmetries.
+   */
+  static uint64_t getTableId() {
+    return solvers::getTableId<DescriptorCount, PossibleTurns, applyTurn,
+                               SolvedDescriptor>(
+        TableKind::ReducedPruning,
+        static_cast<uint64_t>(ClassCount) << 32 | SymmetryCount);
+  }
+};
+
+/**
+ * Equivalent to getSolver, but stores a reduced pruning table from
+ * SymmetryReduction instead of the optimal move of every descriptor. The
+ * tables are built at runtime on the first call rather than during
+ * compilation.
+ */
+template <auto DescriptorCount, auto MinorCount, auto PossibleTurns,
+          auto applyTurn, auto SolvedDescriptor, auto Symmetries>
+consteval auto getSymmetricSolver() {
+  using Reduction = SymmetryReduction<DescriptorCount, MinorCount,
+                                      PossibleTurns, applyTurn,
+                                      SolvedDescriptor, Symmetries>;
+  return [](const typename Reduction::Uint& descriptor) {
+    static const Reduction reduction{};
+    static const auto pruning_table = reduction.getPruningTable();
+    return reduction.solve(pruning_table, descriptor);
+  };
+}
+}  // namespace solvers
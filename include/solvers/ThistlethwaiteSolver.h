@@ -2,9 +2,48 @@
 
 #include "Algorithm.h"
 #include "Cube.h"
+#include <array>
+#include <chrono>
 
 namespace solvers {
-Algorithm solveThistlethwaite(Cube cube);
+/**
+ * The solve of a single stage of Thistlethwaite's algorithm and how long it
+ * took to find.
+ */
+struct ThistlethwaiteStage {
+  const char* name;
+  Algorithm solve;
+  std::chrono::steady_clock::duration duration;
+};
+
+/**
+ * The stages of Thistlethwaite's algorithm in the order that they are solved:
+ * edge orientation (<U, D, R, L, F2, B2>), domino reduction
+ * (<U, D, R2, L2, F2, B2>), half turn reduction (<U2, D2, R2, L2, F2, B2>) and
+ * finally the solved state. Each stage is solved optimally with a lookup
+ * table, so a stage takes at most 7, 10, 13 and 15 moves respectively.
+ */
+struct ThistlethwaiteSolve {
+  std::array<ThistlethwaiteStage, 4> stages;
+
+  /**
+   * @return The concatenation of the solves of every stage.
+   */
+  [[nodiscard]] Algorithm getAlgorithm() const;
+};
+
+/**
+ * @brief Solves the given Cube stage by stage, recording the solve and the
+ * duration of each stage. The lookup tables of the stages are generated (or
+ * loaded from ./lookup_tables) on the first call.
+ */
+ThistlethwaiteSolve solveThistlethwaiteStages(const Cube& cube);
+
+/**
+ * @brief Solves the given Cube in at most 45 moves with Thistlethwaite's
+ * algorithm.
+ */
+Algorithm solveThistlethwaite(const Cube& cube);
 
 void runThistlethwaiteSolverTests();
 }  // namespace solvers
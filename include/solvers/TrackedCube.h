@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Algorithm.h"
+#include "Cube.h"
+#include "Move.h"
+#include "Turn.h"
+#include <cassert>
+#include <cstdint>
+
+namespace solvers {
+/**
+ * A Cube together with its edge orientation, domino reduction and half turn
+ * reduction descriptors, which are updated with the solvers' applyTurn on
+ * every Turn rather than recomputed from the pieces. This makes checking
+ * whether a stage is solved and starting the next stage constant time in
+ * chained solvers and searches, e.g. with the TrackedCube overloads of
+ * areEdgesOriented, isDominoReduced and isHalfTurnReduced.
+ *
+ * The half turn reduction descriptor is only defined while the Cube is domino
+ * reduced, so it is recomputed from the pieces whenever the Cube becomes domino
+ * reduced and only updated incrementally from then on.
+ */
+class TrackedCube {
+ public:
+  TrackedCube() : TrackedCube(Cube{}) {}
+
+  explicit TrackedCube(const Cube& cube);
+
+  void apply(const Turn& turn);
+
+  void apply(const Move& move);
+
+  void apply(const Algorithm& algorithm);
+
+  [[nodiscard]] const Cube& getCube() const { return cube; }
+
+  [[nodiscard]] uint16_t getEdgeOrientationDescriptor() const {
+    return edge_orientation_descriptor;
+  }
+
+  [[nodiscard]] uint32_t getDominoReductionDescriptor() const {
+    return domino_reduction_descriptor;
+  }
+
+  /**
+   * Requires the Cube to be domino reduced.
+   */
+  [[nodiscard]] uint16_t getHalfTurnReductionDescriptor() const {
+    assert(is_domino_reduced);
+    return half_turn_reduction_descriptor;
+  }
+
+ private:
+  Cube cube;
+  uint16_t edge_orientation_descriptor;
+  uint32_t domino_reduction_descriptor;
+  uint16_t half_turn_reduction_descriptor = 0;
+  bool is_domino_reduced = false;
+};
+}  // namespace solvers
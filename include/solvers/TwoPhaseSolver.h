@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Algorithm.h"
+#include "Cube.h"
+#include <chrono>
+#include <cstddef>
+
+namespace solvers {
+/**
+ * @brief Solves the given Cube with Kociemba's two-phase algorithm: phase 1
+ * reaches domino reduction (<U, D, R2, L2, F2, B2>) and phase 2 solves the
+ * Cube within that subgroup, both searched with IDA* over pruning tables.
+ * Longer phase 1 solutions are tried for as long as they can still lead to a
+ * shorter total solve. The Cube is searched rotated onto each of the three
+ * axes and inverted, and until a solve is found, phase 2 only looks for
+ * short solves of at most max_length moves.
+ *
+ * The search stops as soon as a solve of at most max_length moves is found,
+ * or once the timeout has passed and some solve has been found. Passing a
+ * max_length of 0 therefore searches until the timeout.
+ *
+ * The pruning and move tables are generated on the first call, which takes a
+ * few seconds.
+ */
+Algorithm solveTwoPhase(
+    const Cube& cube, size_t max_length = 21,
+    std::chrono::steady_clock::duration timeout = std::chrono::milliseconds{
+        10});
+
+void runTwoPhaseSolverTests();
+}  // namespace solvers
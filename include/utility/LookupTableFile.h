@@ -0,0 +1,90 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace utility {
+/**
+ * The header at the start of every binary lookup table file, followed
+ * immediately by payload_size bytes of PackedBitsArray::rawData. All fields are
+ * stored in native byte order, so files are not portable between machines of
+ * differing endianness (which is caught by the byte order mark check).
+ *
+ * table_id identifies what the table was generated for (e.g. a hash of the
+ * group's applyTurn), since a table for a changed coordinate can have exactly
+ * the same shape as the old one but different contents.
+ */
+struct LookupTableHeader {
+  static constexpr std::array<char, 8> Magic = {'R', 'C', 'L', 'O',
+                                                'O', 'K', 'U', 'P'};
+  static constexpr uint32_t ByteOrderMark = 0x01020304;
+  static constexpr uint32_t CurrentVersion = 2;
+
+  std::array<char, 8> magic;
+  uint32_t byte_order_mark;
+  uint32_t version;
+  uint32_t bits;
+  uint32_t reserved;
+  uint64_t element_count;
+  uint64_t payload_size;
+  uint64_t checksum;
+  uint64_t table_id;
+};
+static_assert(sizeof(LookupTableHeader) == 56);
+
+/**
+ * @return The 64 bit FNV-1a hash of the given bytes.
+ */
+uint64_t getLookupTableChecksum(const uint8_t* data, size_t size);
+
+/**
+ * @brief Writes the given packed lookup table to the given file (creating any
+ * missing parent directories) in the binary format described by
+ * LookupTableHeader. The table is written to a temporary file that is unique
+ * to this process and call, and then renamed to file_name, so a reader never
+ * sees a partially written table even while other processes write the same
+ * one.
+ * @throws std::runtime_error If the file cannot be written.
+ */
+void writeLookupTableFile(const std::string& file_name, uint8_t bits,
+                          uint64_t element_count, uint64_t table_id,
+                          const uint8_t* data, size_t size);
+
+/**
+ * A read-only memory mapping of a binary lookup table file. The payload can be
+ * read through a PackedBitsArrayView of data().
+ */
+class MappedLookupTable {
+ private:
+  void* mapping;
+  size_t mapping_size;
+
+  MappedLookupTable(void* mapping, size_t mapping_size);
+
+ public:
+  /**
+   * @brief Maps the given file and validates its header and checksum against
+   * the expected bits per element, element count and table id.
+   * @return std::nullopt if the file does not exist.
+   * @throws std::runtime_error If the file exists but cannot be mapped, or is
+   * not a valid lookup table with the expected shape and table id.
+   */
+  static std::optional<MappedLookupTable> open(const std::string& file_name,
+                                               uint8_t bits,
+                                               uint64_t element_count,
+                                               uint64_t table_id);
+
+  MappedLookupTable(const MappedLookupTable&) = delete;
+  MappedLookupTable& operator=(const MappedLookupTable&) = delete;
+  MappedLookupTable(MappedLookupTable&& other) noexcept;
+  MappedLookupTable& operator=(MappedLookupTable&& other) noexcept;
+  ~MappedLookupTable();
+
+  [[nodiscard]] const uint8_t* data() const;
+
+  [[nodiscard]] size_t size() const;
+};
+}  // namespace utility
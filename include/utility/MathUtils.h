@@ -21,7 +21,7 @@ template <typename T1, typename T2>
 constexpr auto pow(const T1& base, const T2& exponent) {
   using R = std::common_type_t<T1, T2>;
   R result = 1;
-  for (size_t i = 0; i < exponent; ++i) result *= base;
+  for (T2 i = 0; i < exponent; ++i) result *= base;
   return result;
 }
 
@@ -151,7 +151,7 @@ class Permutation : public std::array<uint8_t, n> {
      */
     Permutation<n> permutation = parseRank(2 * parity_rank);
     if (permutation.isOdd() != is_odd) {
-      [[maybe_unused]] const bool overflowed = permutation.nextPermutation();
+      [[maybe_unused]] const bool overflowed = !permutation.nextPermutation();
       assert(!overflowed);
     }
     return permutation;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <istream>
+#include <optional>
 #include <string>
 #include <utility>
 
@@ -11,4 +13,14 @@ namespace utility {
  */
 std::pair<std::string, std::string> loadScrambleSolve(
     const std::string& file_name);
+
+/**
+ * @brief Reads the next attempt from a stream with one attempt per line, where
+ * the scramble and the solve are separated by a tab character. Blank lines are
+ * skipped, so that arbitrarily large archives can be streamed line by line.
+ * @return The scramble and the solve, or std::nullopt if the stream has no
+ * more attempts.
+ */
+std::optional<std::pair<std::string, std::string>> readScrambleSolve(
+    std::istream& stream);
 }  // namespace utility
@@ -2,8 +2,12 @@
 
 #include <algorithm>
 #include <array>
+#include <cassert>
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
 #include <type_traits>
 #include <vector>
 
@@ -63,14 +67,16 @@ size_t levEditDistance(const std::vector<T>& first,
   // ensure that M <= N, to reduce memory usage
   if (N < M) return levEditDistance(second, first);
 
-  std::vector<size_t> current_row(M);
-  for (size_t m = 0; m < M; ++m) current_row[m] = m;
+  // current_row[m] is the distance between the first n elements of first and
+  // the first m elements of second
+  std::vector<size_t> current_row(M + 1);
+  for (size_t m = 0; m <= M; ++m) current_row[m] = m;
 
-  for (size_t n = 1; n < N; ++n) {
+  for (size_t n = 1; n <= N; ++n) {
     size_t last_row_last_column = current_row[0];
     current_row[0] = n;
-    for (size_t m = 1; m < M; ++m) {
-      if (first[n] != second[m]) {
+    for (size_t m = 1; m <= M; ++m) {
+      if (first[n - 1] != second[m - 1]) {
         // store the desired value of current_row[m] in last_row_last_column
         if (current_row[m - 1] < last_row_last_column)
           last_row_last_column = current_row[m - 1];
@@ -81,6 +87,77 @@ size_t levEditDistance(const std::vector<T>& first,
       std::swap(last_row_last_column, current_row[m]);
     }
   }
-  return current_row[M - 1];
+  return current_row[M];
 }
+
+/**
+ * Computes the same distances as levEditDistance against a fixed pattern of
+ * at most MaxPatternLength elements, using Hyyro's variant of Myers'
+ * bit-parallel algorithm. The pattern is stored as one bit mask per symbol, so
+ * each element of the other sequence costs a constant number of word
+ * operations and nothing is allocated.
+ * @tparam encode Maps each element to a symbol in [0, AlphabetSize), such
+ * that elements are equal if and only if their symbols are.
+ */
+template <typename T, size_t AlphabetSize, auto encode>
+class BitParallelEditDistance {
+ public:
+  static constexpr size_t MaxPatternLength = 64;
+
+ private:
+  // bit i of pattern_masks[symbol] is set if pattern[i] encodes to symbol
+  std::array<uint64_t, AlphabetSize> pattern_masks{};
+  size_t pattern_length;
+
+ public:
+  explicit BitParallelEditDistance(const std::vector<T>& pattern)
+      : pattern_length(pattern.size()) {
+    if (pattern.size() > MaxPatternLength)
+      throw std::invalid_argument("Pattern is too long!");
+    for (size_t i = 0; i < pattern.size(); ++i) {
+      const size_t symbol = encode(pattern[i]);
+      assert(symbol < AlphabetSize);
+      pattern_masks[symbol] |= uint64_t{1} << i;
+    }
+  }
+
+  /**
+   * @param text Any range of T, such as a std::vector or a StaticVector.
+   * @return The Levenshtein edit distance between the pattern and text.
+   */
+  template <typename Text>
+  [[nodiscard]] size_t operator()(const Text& text) const {
+    if (pattern_length == 0)
+      return static_cast<size_t>(std::distance(text.begin(), text.end()));
+
+    // bit i of positive_vertical (negative_vertical) is set if the distance
+    // increases (decreases) from row i to row i + 1 of the current column
+    uint64_t positive_vertical = ~uint64_t{0};
+    uint64_t negative_vertical = 0;
+    const uint64_t last_row = uint64_t{1} << (pattern_length - 1);
+    size_t distance = pattern_length;
+    for (const T& element : text) {
+      const uint64_t equal = pattern_masks[encode(element)];
+      const uint64_t vertical = equal | negative_vertical;
+      const uint64_t horizontal =
+          (((equal & positive_vertical) + positive_vertical) ^
+           positive_vertical) |
+          equal;
+      uint64_t positive_horizontal =
+          negative_vertical | ~(horizontal | positive_vertical);
+      uint64_t negative_horizontal = positive_vertical & horizontal;
+      if (positive_horizontal & last_row)
+        ++distance;
+      else if (negative_horizontal & last_row)
+        --distance;
+      // the distance in row 0 increases by 1 in every column
+      positive_horizontal = (positive_horizontal << 1) | 1;
+      negative_horizontal <<= 1;
+      positive_vertical =
+          negative_horizontal | ~(vertical | positive_horizontal);
+      negative_vertical = positive_horizontal & vertical;
+    }
+    return distance;
+  }
+};
 }  // namespace utility
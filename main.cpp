@@ -1,10 +1,14 @@
 // #define NDEBUG // uncomment to disable asserts
 
 #include "Algorithm.h"
+#include "BatchReconstruction.h"
 #include "Blindsolving.h"
 #include "RunTests.h"
 #include "SolveAttemptParsingUtils.h"
+#include <cstddef>
+#include <fstream>
 #include <iostream>
+#include <string>
 
 static void viewReconstruction(const std::string& file_name) {
   using namespace blindsolving;
@@ -19,9 +23,9 @@ static void viewReconstruction(const std::string& file_name) {
   ReconstructionIterator it = getReconstructionIterator(Cube{scramble});
 
   std::cout << "Processing " << it.getPeriod() << " reconstructions...\n";
-  const size_t n = std::min(it.getPeriod(), 3ull);
+  const size_t n = std::min(it.getPeriod(), size_t{3});
   const std::vector<std::pair<BlindsolvingReconstruction, size_t>>
-      best_reconstructions = getBestReconstructions(reconstruction, it, n);
+      best_reconstructions = searchBestReconstructions(reconstruction, it, n);
 
   std::cout << "Closest reconstruction matches:\n";
   for (const auto& [recon, edit_distance] : best_reconstructions)
@@ -29,7 +33,38 @@ static void viewReconstruction(const std::string& file_name) {
               << '\n';
 }
 
-int main() {
+/**
+ * Streams the attempts in input_file_name (one "<scramble>\t<solve>" per line)
+ * to output_file_name, or to stdout if it is empty.
+ */
+static int reconstructBatch(const std::string& input_file_name,
+                            const std::string& output_file_name) {
+  std::ifstream input(input_file_name);
+  if (!input) {
+    std::cerr << "Could not open " << input_file_name << '\n';
+    return 1;
+  }
+  std::ofstream output_file;
+  if (!output_file_name.empty()) {
+    output_file.open(output_file_name);
+    if (!output_file) {
+      std::cerr << "Could not open " << output_file_name << '\n';
+      return 1;
+    }
+  }
+  const blindsolving::BatchStatistics statistics =
+      blindsolving::reconstructBatch(
+          input, output_file_name.empty() ? std::cout : output_file);
+  std::cerr << "Reconstructed " << statistics.attempt_count << " attempts ("
+            << statistics.failure_count << " failed) in " << statistics.seconds
+            << "s, " << statistics.attempt_count / statistics.seconds
+            << " attempts per second\n";
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  if (argc > 2 && std::string{argv[1]} == "--batch")
+    return reconstructBatch(argv[2], argc > 3 ? argv[3] : "");
   runTests();
   viewReconstruction("tests/blindsolve3.txt");
   return 0;
@@ -0,0 +1,84 @@
+#include "Microbenchmark.h"
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+
+static std::atomic<size_t> allocation_count{0};
+
+// Replacing the plain and aligned forms is sufficient: the array and nothrow
+// forms are implemented in terms of them.
+
+void* operator new(size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) return ptr;
+  throw std::bad_alloc{};
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  const auto align = static_cast<size_t>(alignment);
+  // std::aligned_alloc requires size to be a multiple of the alignment
+  const size_t rounded_size = (size + align - 1) / align * align;
+  if (void* ptr = std::aligned_alloc(align, rounded_size == 0 ? align
+                                                              : rounded_size))
+    return ptr;
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+
+size_t getAllocationCount() {
+  return allocation_count.load(std::memory_order_relaxed);
+}
+
+void printResults(std::ostream& os,
+                  const std::vector<MicrobenchmarkResult>& results) {
+  size_t name_width = 0;
+  for (const MicrobenchmarkResult& result : results)
+    name_width = std::max(name_width, result.name.size());
+
+  for (const MicrobenchmarkResult& result : results)
+    os << std::left << std::setw(static_cast<int>(name_width) + 2)
+       << result.name << std::right << std::fixed << std::setprecision(1)
+       << std::setw(14) << result.ns_per_op << " ns/op" << std::setw(16)
+       << result.ops_per_second << " ops/s" << std::setprecision(2)
+       << std::setw(10) << result.allocations_per_op << " allocs/op\n";
+  os << std::defaultfloat;
+}
+
+/**
+ * Writes s as a JSON string literal. Benchmark names are plain ASCII, so only
+ * quotes and backslashes need to be escaped.
+ */
+static void writeJsonString(std::ostream& os, const std::string& s) {
+  os << '"';
+  for (const char& c : s) {
+    if (c == '"' || c == '\\') os << '\\';
+    os << c;
+  }
+  os << '"';
+}
+
+void writeJson(std::ostream& os,
+               const std::vector<MicrobenchmarkResult>& results) {
+  os << "{\n  \"benchmarks\": [";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const MicrobenchmarkResult& result = results[i];
+    os << (i == 0 ? "\n" : ",\n") << "    {\"name\": ";
+    writeJsonString(os, result.name);
+    os << ", \"iterations\": " << result.iterations
+       << ", \"ns_per_op\": " << result.ns_per_op
+       << ", \"ops_per_second\": " << result.ops_per_second
+       << ", \"allocations_per_op\": " << result.allocations_per_op << '}';
+  }
+  os << "\n  ]\n}\n";
+}
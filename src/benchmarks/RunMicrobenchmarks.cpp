@@ -0,0 +1,503 @@
+#include "Algorithm.h"
+#include "Blindsolving.h"
+#include "BlindsolvingMove.h"
+#include "BlindsolvingReconstruction.h"
+#include "CompactAlgorithm.h"
+#include "CornerLocation.h"
+#include "Cube.h"
+#include "CubieCube.h"
+#include "DominoReductionSolver.h"
+#include "EdgeLocation.h"
+#include "EdgeOrientationSolver.h"
+#include "Microbenchmark.h"
+#include "Move.h"
+#include "PackedBitsArray.h"
+#include "Reconstruction.h"
+#include "ReconstructionIterator.h"
+#include "SolveAttemptParsingUtils.h"
+#include "ThistlethwaiteSolver.h"
+#include "TrackedCube.h"
+#include "Turn.h"
+#include "TurnSets.h"
+#include "TwoPhaseSolver.h"
+#include "Utils.h"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Every input is generated from this fixed seed (rather than with
+// utility::random_engine) so that consecutive runs measure the same work.
+static constexpr unsigned Seed = 2024;
+
+#ifdef RUBIKS_CUBE_SOURCE_DIR
+static const std::string TestDataDirectory =
+    std::string{RUBIKS_CUBE_SOURCE_DIR} + "/tests/";
+#else
+static const std::string TestDataDirectory = "tests/";
+#endif
+
+/**
+ * Cycles through a fixed set of inputs so that each operation gets a
+ * different one without the selection itself costing much.
+ */
+template <typename T>
+class InputCycle {
+ public:
+  explicit InputCycle(std::vector<T> inputs) : inputs(std::move(inputs)) {}
+
+  const T& next() {
+    const T& input = inputs[index];
+    index = index + 1 == inputs.size() ? 0 : index + 1;
+    return input;
+  }
+
+ private:
+  std::vector<T> inputs;
+  size_t index = 0;
+};
+
+static std::vector<Algorithm> randomAlgorithms(const size_t& count,
+                                               const size_t& length,
+                                               std::mt19937& engine) {
+  std::uniform_int_distribution<size_t> distribution(
+      0, AllPossibleTurns.size() - 1);
+  std::vector<Algorithm> algorithms(count);
+  for (Algorithm& alg : algorithms) {
+    while (alg.size() < length) {
+      while (alg.size() < length)
+        alg.push_back(Move{AllPossibleTurns[distribution(engine)]});
+      alg.cancelMoves();
+    }
+  }
+  return algorithms;
+}
+
+static std::vector<Cube> randomCubes(const size_t& count,
+                                     std::mt19937& engine) {
+  std::vector<Cube> cubes;
+  cubes.reserve(count);
+  for (const Algorithm& scramble : randomAlgorithms(count, 25, engine))
+    cubes.emplace_back(scramble);
+  return cubes;
+}
+
+/**
+ * The inputs of the core microbenchmarks. cancelMoves is measured on the
+ * concatenation of an algorithm and its inverse, which cancels completely.
+ */
+struct CoreInputs {
+  std::vector<Algorithm> algorithms;
+  std::vector<CompactAlgorithm> compact_algorithms;
+  std::vector<Turn> turns;
+  std::vector<std::string> alg_strs;
+  std::string alg_file;  // alg_strs, one per line
+  std::vector<Algorithm> cancellable;
+  std::vector<CompactAlgorithm> compact_cancellable;
+  std::vector<std::array<EdgeLocation, 2>> edge_swaps;
+  std::vector<std::array<CornerLocation, 2>> corner_swaps;
+};
+
+static CoreInputs makeCoreInputs() {
+  std::mt19937 engine{Seed};
+  CoreInputs inputs;
+  inputs.algorithms = randomAlgorithms(1024, 20, engine);
+  for (const Algorithm& alg : inputs.algorithms) {
+    inputs.compact_algorithms.emplace_back(alg);
+    for (const Move& move : alg) inputs.turns.push_back(move.getTurn());
+    inputs.alg_strs.push_back(alg.toStr());
+    inputs.alg_file += inputs.alg_strs.back() + '\n';
+    Algorithm& cancellable_alg = inputs.cancellable.emplace_back(alg);
+    const Algorithm inverse = alg.inv();
+    cancellable_alg.insert(cancellable_alg.end(), inverse.begin(),
+                           inverse.end());
+    inputs.compact_cancellable.emplace_back(cancellable_alg);
+  }
+  // the first location of each swap is flipped or rotated so that the lookups
+  // also have to find the orientation of the piece
+  std::uniform_int_distribution<size_t> edge_distribution(
+      0, Cube::EdgeLocationOrder.size() - 1);
+  std::uniform_int_distribution<size_t> corner_distribution(
+      0, Cube::CornerLocationOrder.size() - 1);
+  for (size_t i = 0; i < 1024; ++i) {
+    inputs.edge_swaps.push_back(
+        {Cube::EdgeLocationOrder[edge_distribution(engine)].flip(),
+         Cube::EdgeLocationOrder[edge_distribution(engine)]});
+    inputs.corner_swaps.push_back(
+        {Cube::CornerLocationOrder[corner_distribution(engine)]
+             .rotateClockwise(),
+         Cube::CornerLocationOrder[corner_distribution(engine)]});
+  }
+  return inputs;
+}
+
+static void runCoreMicrobenchmarks(MicrobenchmarkSuite& suite) {
+  Lazy inputs{makeCoreInputs};
+
+  suite.add("Cube::apply(Turn)", [&] {
+    return [cube = Cube{}, turn = InputCycle{inputs->turns}]() mutable {
+      cube.apply(turn.next());
+      doNotOptimize(cube);
+    };
+  });
+  suite.add("Cube::apply(Algorithm)", [&] {
+    return [cube = Cube{}, alg = InputCycle{inputs->algorithms}]() mutable {
+      cube.apply(alg.next());
+      doNotOptimize(cube);
+    };
+  });
+  suite.add("Cube::apply(CompactAlgorithm)", [&] {
+    return [cube = Cube{},
+            alg = InputCycle{inputs->compact_algorithms}]() mutable {
+      cube.apply(alg.next());
+      doNotOptimize(cube);
+    };
+  });
+  // each swap of two pieces looks up 4 locations with Cube::operator[]
+  suite.add("Cube::cycleEdges<2>", [&] {
+    return [cube = Cube{}, swap = InputCycle{inputs->edge_swaps}]() mutable {
+      cube.cycleEdges<2>(swap.next());
+      doNotOptimize(cube);
+    };
+  });
+  suite.add("Cube::cycleCorners<2>", [&] {
+    return [cube = Cube{}, swap = InputCycle{inputs->corner_swaps}]() mutable {
+      cube.cycleCorners<2>(swap.next());
+      doNotOptimize(cube);
+    };
+  });
+  suite.add("CubieCube::apply(Turn)", [&] {
+    return [cube = CubieCube{}, turn = InputCycle{inputs->turns}]() mutable {
+      cube.apply(turn.next());
+      doNotOptimize(cube);
+    };
+  });
+  suite.add("CubieCube::applyScalar(Turn)", [&] {
+    return [cube = CubieCube{}, turn = InputCycle{inputs->turns}]() mutable {
+      cube.applyScalar(turn.next());
+      doNotOptimize(cube);
+    };
+  });
+  suite.add("Algorithm::parse", [&] {
+    return [alg_str = InputCycle{inputs->alg_strs}]() mutable {
+      doNotOptimize(Algorithm::parse(alg_str.next()));
+    };
+  });
+  suite.add("Algorithm::parse (file)", [&] {
+    return [&alg_file = inputs->alg_file] {
+      doNotOptimize(Algorithm::parse(alg_file));
+    };
+  });
+  suite.add("Algorithm::parseExpanded (file)", [&] {
+    return [&alg_file = inputs->alg_file] {
+      doNotOptimize(Algorithm::parseExpanded(alg_file));
+    };
+  });
+  suite.add("Algorithm::cancelMoves", [&] {
+    return [alg = InputCycle{inputs->cancellable}]() mutable {
+      Algorithm copy = alg.next();
+      copy.cancelMoves();
+      doNotOptimize(copy);
+    };
+  });
+  suite.add("CompactAlgorithm::cancelMoves", [&] {
+    return [alg = InputCycle{inputs->compact_cancellable}]() mutable {
+      CompactAlgorithm copy = alg.next();
+      copy.cancelMoves();
+      doNotOptimize(copy);
+    };
+  });
+}
+
+template <uint8_t bits>
+struct PackedBitsArrayInputs {
+  static constexpr size_t Size = size_t{1} << 22;
+  using Table = utility::PackedBitsArray<bits, Size, true>;
+
+  std::unique_ptr<Table> table;
+  std::vector<size_t> indices;  // for the random reads
+};
+
+template <uint8_t bits>
+static PackedBitsArrayInputs<bits> makePackedBitsArrayInputs() {
+  using Inputs = PackedBitsArrayInputs<bits>;
+  std::mt19937_64 engine{Seed};
+  std::uniform_int_distribution<size_t> index_distribution(0, Inputs::Size - 1);
+  Inputs inputs{std::make_unique<typename Inputs::Table>(),
+                std::vector<size_t>(4096)};
+  for (size_t i = 0; i < Inputs::Size; ++i)
+    (*inputs.table)[i] = static_cast<typename Inputs::Table::const_reference>(
+        engine() >> (64 - bits));
+  for (size_t& i : inputs.indices) i = index_distribution(engine);
+  return inputs;
+}
+
+/**
+ * The per-element read that PackedBitsArray::operator[] performed before it
+ * used 64-bit loads.
+ */
+template <uint8_t bits>
+static auto parseElement(const uint8_t* const data, const size_t& i) {
+  const size_t bit_index = i * bits;
+  if constexpr (bits % 8 == 0)
+    return utility::PackedBitsReference<bits>::parse(&data[bit_index / 8], {});
+  else
+    return utility::PackedBitsReference<bits>::parse(
+        &data[bit_index / 8], static_cast<uint8_t>(bit_index % 8));
+}
+
+/**
+ * Compares reading blocks of BlockSize consecutive elements through the
+ * per-element PackedBitsReference::parse, operator[] and decode, as well as
+ * random reads through parse and operator[].
+ */
+template <uint8_t bits>
+static void runPackedBitsArrayMicrobenchmarks(MicrobenchmarkSuite& suite) {
+  using Inputs = PackedBitsArrayInputs<bits>;
+  static constexpr size_t Size = Inputs::Size;
+  static constexpr size_t BlockSize = 256;
+  using value_type = typename Inputs::Table::const_reference;
+  const std::string prefix = "PackedBitsArray<" + std::to_string(bits) + ">";
+  const std::string block_suffix = " x" + std::to_string(BlockSize);
+  Lazy inputs{makePackedBitsArrayInputs<bits>};
+
+  suite.add(prefix + " parse" + block_suffix, [&] {
+    return [data = inputs->table->rawData().data(),
+            block = std::vector<value_type>(BlockSize),
+            first = size_t{0}]() mutable {
+      for (size_t i = 0; i < BlockSize; ++i)
+        block[i] = parseElement<bits>(data, first + i);
+      doNotOptimize(block.data());
+      first = (first + BlockSize) % Size;
+    };
+  });
+  suite.add(prefix + "::operator[]" + block_suffix, [&] {
+    return [&table = std::as_const(*inputs->table),
+            block = std::vector<value_type>(BlockSize),
+            first = size_t{0}]() mutable {
+      for (size_t i = 0; i < BlockSize; ++i) block[i] = table[first + i];
+      doNotOptimize(block.data());
+      first = (first + BlockSize) % Size;
+    };
+  });
+  suite.add(prefix + "::decode" + block_suffix, [&] {
+    return [&table = std::as_const(*inputs->table),
+            block = std::vector<value_type>(BlockSize),
+            first = size_t{0}]() mutable {
+      doNotOptimize(table.decode(first, block).data());
+      first = (first + BlockSize) % Size;
+    };
+  });
+  suite.add(prefix + " parse (random)", [&] {
+    return [data = inputs->table->rawData().data(),
+            i = InputCycle{inputs->indices}]() mutable {
+      doNotOptimize(parseElement<bits>(data, i.next()));
+    };
+  });
+  suite.add(prefix + "::operator[] (random)", [&] {
+    return [&table = std::as_const(*inputs->table),
+            i = InputCycle{inputs->indices}]() mutable {
+      doNotOptimize(table[i.next()]);
+    };
+  });
+}
+
+static void runUtilityMicrobenchmarks(MicrobenchmarkSuite& suite) {
+  // the widths of a pruning table and of a compressed optimal move table
+  runPackedBitsArrayMicrobenchmarks<2>(suite);
+  runPackedBitsArrayMicrobenchmarks<19>(suite);
+}
+
+struct SolverInputs {
+  std::vector<Cube> cubes;
+  std::vector<Turn> turns;
+};
+
+static SolverInputs makeSolverInputs() {
+  std::mt19937 engine{Seed};
+  SolverInputs inputs{randomCubes(256, engine), {}};
+  for (const Algorithm& alg : randomAlgorithms(64, 20, engine))
+    for (const Move& move : alg) inputs.turns.push_back(move.getTurn());
+  return inputs;
+}
+
+static void runSolverMicrobenchmarks(MicrobenchmarkSuite& suite) {
+  Lazy inputs{makeSolverInputs};
+
+  suite.add("TrackedCube::apply(Turn)", [&] {
+    return [cube = solvers::TrackedCube{},
+            turn = InputCycle{inputs->turns}]() mutable {
+      cube.apply(turn.next());
+      doNotOptimize(cube);
+    };
+  });
+  suite.add("solveEdgeOrientation", [&] {
+    return [cube = InputCycle{inputs->cubes}]() mutable {
+      doNotOptimize(solvers::solveEdgeOrientation(cube.next()));
+    };
+  });
+  suite.add("solveDominoReduction", [&] {
+    return [cube = InputCycle{inputs->cubes}]() mutable {
+      doNotOptimize(solvers::solveDominoReduction(cube.next()));
+    };
+  });
+  suite.add("solveThistlethwaite", [&] {
+    return [cube = InputCycle{inputs->cubes}]() mutable {
+      doNotOptimize(solvers::solveThistlethwaite(cube.next()));
+    };
+  });
+  suite.add("solveTwoPhase", [&] {
+    return [cube = InputCycle{inputs->cubes}]() mutable {
+      doNotOptimize(solvers::solveTwoPhase(cube.next()));
+    };
+  });
+  // the time to find a solve within a length bound, rather than the best
+  // solve found before the default timeout
+  for (const size_t max_length : {size_t{22}, size_t{21}}) {
+    suite.add("solveTwoPhase (" + std::to_string(max_length) + " moves)", [&] {
+      return [cube = InputCycle{inputs->cubes}, max_length]() mutable {
+        doNotOptimize(solvers::solveTwoPhase(cube.next(), max_length,
+                                             std::chrono::seconds{10}));
+      };
+    });
+  }
+}
+
+/**
+ * The inputs of the blindsolving microbenchmarks. The edit distances are
+ * measured between the first and each of the following reconstructions of a
+ * random scramble.
+ */
+struct BlindsolvingInputs {
+  std::vector<Cube> cubes;
+  Algorithm solve;
+  blindsolving::Reconstruction reconstruction;
+  blindsolving::ReconstructionIterator it;
+  std::vector<blindsolving::BlindsolvingReconstruction> reconstructions;
+};
+
+static BlindsolvingInputs makeBlindsolvingInputs() {
+  std::mt19937 engine{Seed};
+  std::vector<Cube> cubes = randomCubes(256, engine);
+  const auto [scramble_str, solve_str] =
+      utility::loadScrambleSolve(TestDataDirectory + "blindsolve2.txt");
+  Algorithm solve = Algorithm::parseExpanded(solve_str);
+  blindsolving::Reconstruction reconstruction =
+      blindsolving::parseSolveAttempt(solve);
+  BlindsolvingInputs inputs{
+      std::move(cubes), std::move(solve), std::move(reconstruction),
+      blindsolving::getReconstructionIterator(
+          Cube{Algorithm::parse(scramble_str)}),
+      {}};
+  blindsolving::ReconstructionIterator it =
+      blindsolving::getReconstructionIterator(inputs.cubes.front());
+  for (size_t i = 0; i < 1024; ++i, ++it)
+    inputs.reconstructions.push_back(*it);
+  return inputs;
+}
+
+static void runBlindsolvingMicrobenchmarks(MicrobenchmarkSuite& suite) {
+  using ReconstructionEditDistance = utility::BitParallelEditDistance<
+      blindsolving::BlindsolvingMove,
+      blindsolving::BlindsolvingMoveAlphabetSize, blindsolving::encode>;
+  Lazy inputs{makeBlindsolvingInputs};
+
+  suite.add("parseSolveAttempt", [&] {
+    return [&solve = inputs->solve] {
+      doNotOptimize(blindsolving::parseSolveAttempt(solve));
+    };
+  });
+  suite.add("getReconstructionIterator", [&] {
+    return [cube = InputCycle{inputs->cubes}]() mutable {
+      doNotOptimize(blindsolving::getReconstructionIterator(cube.next()));
+    };
+  });
+  suite.add("ReconstructionIterator::writeTo", [&] {
+    return [buffer = blindsolving::ReconstructionIterator::Buffer{},
+            it = inputs->it]() mutable {
+      it.writeTo(buffer);
+      doNotOptimize(buffer);
+      ++it;
+    };
+  });
+  suite.add("levEditDistance", [&] {
+    return [&baseline = inputs->reconstructions.front(),
+            reconstruction = InputCycle{inputs->reconstructions}]() mutable {
+      doNotOptimize(utility::levEditDistance(baseline, reconstruction.next()));
+    };
+  });
+  suite.add("BitParallelEditDistance", [&] {
+    return [edit_distance =
+                ReconstructionEditDistance{inputs->reconstructions.front()},
+            reconstruction = InputCycle{inputs->reconstructions}]() mutable {
+      doNotOptimize(edit_distance(reconstruction.next()));
+    };
+  });
+  suite.add("getBestReconstructions", [&] {
+    return [&reconstruction = inputs->reconstruction,
+            it = inputs->it]() mutable {
+      doNotOptimize(
+          blindsolving::getBestReconstructions(reconstruction, it, 3));
+    };
+  });
+  suite.add("getBestReconstructionsParallel", [&] {
+    return [&reconstruction = inputs->reconstruction, &it = inputs->it] {
+      doNotOptimize(
+          blindsolving::getBestReconstructionsParallel(reconstruction, it, 3));
+    };
+  });
+  suite.add("searchBestReconstructions", [&] {
+    return [&reconstruction = inputs->reconstruction, &it = inputs->it] {
+      doNotOptimize(
+          blindsolving::searchBestReconstructions(reconstruction, it, 3));
+    };
+  });
+}
+
+/**
+ * Usage: rubiks_cube_bench [--filter <substring>] [--json <file>]
+ *
+ * Runs every microbenchmark whose name contains the filter, prints the results
+ * and optionally writes them as JSON so that they can be compared between
+ * releases.
+ */
+int main(int argc, char* argv[]) {
+  std::string filter;
+  std::string json_file_name;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg{argv[i]};
+    if (arg == "--filter" && i + 1 < argc)
+      filter = argv[++i];
+    else if (arg == "--json" && i + 1 < argc)
+      json_file_name = argv[++i];
+    else {
+      std::cerr << "Usage: " << argv[0]
+                << " [--filter <substring>] [--json <file>]\n";
+      return 1;
+    }
+  }
+
+  MicrobenchmarkSuite suite{filter};
+  runCoreMicrobenchmarks(suite);
+  runUtilityMicrobenchmarks(suite);
+  runSolverMicrobenchmarks(suite);
+  runBlindsolvingMicrobenchmarks(suite);
+  printResults(std::cout, suite.getResults());
+
+  if (!json_file_name.empty()) {
+    std::ofstream json_file(json_file_name);
+    if (!json_file) {
+      std::cerr << "Could not open " << json_file_name << '\n';
+      return 1;
+    }
+    writeJson(json_file, suite.getResults());
+  }
+  return 0;
+}
@@ -0,0 +1,132 @@
+#include "BatchReconstruction.h"
+#include "Algorithm.h"
+#include "Blindsolving.h"
+#include "BlindsolvingReconstruction.h"
+#include "Cube.h"
+#include "Reconstruction.h"
+#include "ReconstructionIterator.h"
+#include "SolveAttemptParsingUtils.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace blindsolving {
+/**
+ * @return The edit distance, the parsed attempt, and the closest
+ * reconstruction, separated by tab characters.
+ */
+static std::string reconstructAttempt(const std::string& scramble_str,
+                                      const std::string& solve_str) {
+  // use parseExpanded for the attempted solution so that the division between
+  // blindsolving moves can easily be determined
+  const Reconstruction reconstruction =
+      parseSolveAttempt(Algorithm::parseExpanded(solve_str));
+  ReconstructionIterator it =
+      getReconstructionIterator(Cube{Algorithm::parse(scramble_str)});
+  const auto [best_reconstruction, edit_distance] =
+      searchBestReconstructions(reconstruction, it, 1).front();
+  return std::to_string(edit_distance) + '\t' + reconstruction.toStr() +
+         '\t' + best_reconstruction.toStr();
+}
+
+BatchStatistics reconstructBatch(std::istream& input, std::ostream& output,
+                                 const size_t& thread_count,
+                                 const size_t& max_pending) {
+  const auto t_start = std::chrono::steady_clock::now();
+  const size_t worker_count = std::max(thread_count, size_t{1});
+  const size_t capacity = std::max(max_pending, size_t{1});
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  // pending[k] is the line for attempt written_count + k once it is done
+  std::deque<std::optional<std::string>> pending;
+  size_t read_count = 0;
+  size_t written_count = 0;
+  size_t failure_count = 0;
+  bool is_exhausted = false;
+
+  const auto work = [&]() {
+    std::unique_lock lock(mutex);
+    while (true) {
+      condition.wait(lock, [&]() {
+        return is_exhausted || pending.size() < capacity;
+      });
+      if (is_exhausted) return;
+
+      // input is read by one thread at a time, so attempts keep their order
+      std::optional<std::pair<std::string, std::string>> attempt;
+      std::string error;
+      try {
+        attempt = utility::readScrambleSolve(input);
+        if (!attempt) {
+          is_exhausted = true;
+          condition.notify_all();
+          return;
+        }
+      } catch (const std::exception& e) {
+        error = e.what();
+      }
+      const size_t index = read_count++;
+      pending.emplace_back();
+      lock.unlock();
+
+      std::string line = std::to_string(index) + '\t';
+      if (error.empty()) {
+        try {
+          line += reconstructAttempt(attempt->first, attempt->second);
+        } catch (const std::exception& e) {
+          error = e.what();
+        }
+      }
+      if (!error.empty()) line += "error\t" + error;
+
+      lock.lock();
+      if (!error.empty()) ++failure_count;
+      pending[index - written_count] = std::move(line);
+      condition.notify_all();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(worker_count);
+  for (size_t i = 0; i < worker_count; ++i)
+    threads.emplace_back(work);
+
+  // write the finished prefix of pending without blocking the workers
+  std::vector<std::string> lines;
+  std::unique_lock lock(mutex);
+  while (true) {
+    condition.wait(lock, [&]() {
+      return (!pending.empty() && pending.front()) ||
+             (is_exhausted && pending.empty());
+    });
+    if (pending.empty()) break;
+    while (!pending.empty() && pending.front()) {
+      lines.push_back(std::move(*pending.front()));
+      pending.pop_front();
+      ++written_count;
+    }
+    condition.notify_all();
+    lock.unlock();
+    for (const std::string& line : lines) output << line << '\n';
+    output.flush();
+    lines.clear();
+    lock.lock();
+  }
+  lock.unlock();
+  for (std::thread& thread : threads) thread.join();
+
+  const std::chrono::duration<double> seconds =
+      std::chrono::steady_clock::now() - t_start;
+  return {read_count, failure_count, seconds.count()};
+}
+}  // namespace blindsolving
@@ -1,13 +1,29 @@
 #include "Blindsolving.h"
+#include "BlindsolvingMove.h"
 #include "BlindsolvingReconstruction.h"
+#include "CornerRotationAmount.h"
 #include "Cube.h"
+#include "Face.h"
 #include "Lettering.h"
+#include "MathUtils.h"
 #include "PLL.h"
 #include "Reconstruction.h"
 #include "ReconstructionIterator.h"
+#include "RotationAmount.h"
+#include "Turn.h"
+#include "TurnSets.h"
 #include "Utils.h"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
 #include <stdexcept>
+#include <thread>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace blindsolving {
 static const Algorithm A_ALG =  // NOLINT(cert-err58-cpp)
@@ -72,6 +88,86 @@ const std::unordered_map<char, Algorithm>
 const Algorithm PARITY_ALG =  // NOLINT(cert-err58-cpp)
     A_ALG.withSetup("D' L2 D");
 
+/**
+ * Appends move to alg, merging it into the last move of alg if both are Turns
+ * of the same face.
+ */
+static void appendMove(Algorithm& alg, const Move& move) {
+  if (alg.empty() || !alg.back().isTurn() || !move.isTurn() ||
+      alg.back().getTurn().face != move.getTurn().face) {
+    alg.push_back(move);
+    return;
+  }
+  alg.back().getTurn().rotation_amount += move.getTurn().rotation_amount;
+  if (alg.back().getTurn().rotation_amount == RotationAmount::None)
+    alg.pop_back();
+}
+
+/**
+ * @return Whether the Turns of moves starting at start, all on the face of
+ * turn, add up to turn at some point.
+ */
+static bool completesTurn(const Algorithm& moves, const size_t& start,
+                          const CubeOrientation& orientation,
+                          const Turn& turn) {
+  RotationAmount rotation_amount = RotationAmount::None;
+  for (size_t i = start; i < moves.size(); ++i) {
+    const Move move = orientation.apply(moves[i]);
+    if (!move.isTurn() || move.getTurn().face != turn.face) return false;
+    rotation_amount += move.getTurn().rotation_amount;
+    if (rotation_amount == turn.rotation_amount) return true;
+  }
+  return false;
+}
+
+/**
+ * The alg that produces a Cube, and whether it was found one Turn short.
+ */
+struct AlgMatch {
+  BlindsolvingMove blindsolving_move;
+  // the Turn that the attempt cancelled from the end of the alg
+  std::optional<Turn> cancelled_turn;
+};
+
+/**
+ * @brief Maps the Cube that each of the given algs produces to the alg.
+ *
+ * Besides the Cube each alg produces, every Cube one Turn short of it is also
+ * a key, for when the last Turn of the alg cancels with the start of the next
+ * one. Both are found with the same single lookup, so parsing stays linear in
+ * the number of moves. Exact matches take precedence over cancelled ones, and
+ * a Cube one Turn short of several different algs is left out, since it cannot
+ * tell them apart.
+ */
+static std::unordered_map<Cube, AlgMatch> getAlgMatches(
+    const std::vector<std::pair<BlindsolvingMove, Algorithm>>& algs) {
+  std::unordered_map<Cube, AlgMatch> alg_matches;
+  for (const auto& [blindsolving_move, alg] : algs) {
+    [[maybe_unused]] const bool inserted =
+        alg_matches
+            .try_emplace(Cube{alg}, AlgMatch{blindsolving_move, std::nullopt})
+            .second;
+    assert(inserted);
+  }
+
+  // std::nullopt marks a Cube one Turn short of several algs
+  std::unordered_map<Cube, std::optional<AlgMatch>> cancelled_matches;
+  for (const auto& [blindsolving_move, alg] : algs) {
+    for (const Turn& turn : AllPossibleTurns) {
+      Cube cancelled_cube{alg};
+      cancelled_cube.apply(turn.inv());
+      const auto [match, inserted] = cancelled_matches.try_emplace(
+          cancelled_cube, AlgMatch{blindsolving_move, turn});
+      if (!inserted && match->second &&
+          match->second->blindsolving_move != blindsolving_move)
+        match->second.reset();
+    }
+  }
+  for (const auto& [cancelled_cube, match] : cancelled_matches)
+    if (match) alg_matches.try_emplace(cancelled_cube, *match);
+  return alg_matches;
+}
+
 Reconstruction parseSolveAttempt(const Algorithm& moves) {
   size_t consumed = 0;
 
@@ -87,71 +183,79 @@ Reconstruction parseSolveAttempt(const Algorithm& moves) {
     }
   }
 
-  // set up transformations statically
   // TODO: make this constexpr
-  static std::unordered_map<char, Cube> edge_alg_transformations = []() {
-    std::unordered_map<char, Cube> transformations;
+  static const std::unordered_map<Cube, AlgMatch> alg_matches = []() {
+    std::vector<std::pair<BlindsolvingMove, Algorithm>> algs;
     for (const auto& [chr, alg] : EDGE_ALGS)
-      transformations.insert({chr, Cube{alg}});
-    return transformations;
-  }();
-  static std::unordered_map<char, Cube> corner_alg_transformations = []() {
-    std::unordered_map<char, Cube> transformations;
+      algs.emplace_back(BlindsolvingMove{true, chr}, alg);
     for (const auto& [chr, alg] : CORNER_ALGS)
-      transformations.insert({chr, Cube{alg}});
-    return transformations;
+      algs.emplace_back(BlindsolvingMove{false, chr}, alg);
+    algs.emplace_back(BlindsolvingMove{}, PARITY_ALG);
+    return getAlgMatches(algs);
   }();
-  static const Cube parity_alg_transformation{PARITY_ALG};
+  const CubeOrientation inverse_orientation = orientation.inv();
 
   Reconstruction reconstruction;
+  // the inverse of the Turn cancelled from the end of the last matched alg,
+  // which the next alg must start with
+  std::optional<Move> carried_move;
   while (consumed < moves.size()) {
     bool found_match = false;
-    SolveData solve_data{};
     Cube test_transformation{};
+    Algorithm alg_moves;
+    if (carried_move) {
+      test_transformation.apply(orientation.apply(*carried_move));
+      alg_moves.push_back(*carried_move);
+    }
     for (size_t i = consumed; i < moves.size(); i++) {
-      // TODO: check all 3 RotationAmounts for this Move to allow for detecting
-      //       BlindSolvingMoves where turns are cancelled
       test_transformation.apply(orientation.apply(moves[i]));
+      // only the carried move is merged, so the attempt is otherwise verbatim
+      if (i == consumed)
+        appendMove(alg_moves, moves[i]);
+      else
+        alg_moves.push_back(moves[i]);
 
-      for (auto [chr, transformation] : edge_alg_transformations) {
-        if (test_transformation == transformation) {
-          found_match = true;
-          solve_data.moves = moves.subAlgorithm(consumed, i + 1);
-          solve_data.is_parsed = true;
-          solve_data.blindsolving_move.is_parity = false;
-          solve_data.blindsolving_move.is_edge = true;
-          solve_data.blindsolving_move.alg = chr;
-          break;
-        }
-      }
-      for (auto [chr, transformation] : corner_alg_transformations) {
-        if (test_transformation == transformation) {
-          found_match = true;
-          solve_data.moves = moves.subAlgorithm(consumed, i + 1);
-          solve_data.is_parsed = true;
-          solve_data.blindsolving_move.is_parity = false;
-          solve_data.blindsolving_move.is_edge = false;
-          solve_data.blindsolving_move.alg = chr;
-          break;
-        }
+      const auto match = alg_matches.find(test_transformation);
+      if (match == alg_matches.end()) continue;
+      if (const std::optional<Turn>& cancelled_turn =
+              match->second.cancelled_turn) {
+        // a cancelled Turn must be undone by a later alg, so the last move of
+        // the attempt can only finish an exact match
+        if (i + 1 == moves.size()) continue;
+        // if the next moves on the same face add up to the cancelled Turn,
+        // they finish an exact match instead
+        if (completesTurn(moves, i + 1, orientation, *cancelled_turn))
+          continue;
       }
-      if (test_transformation == parity_alg_transformation) {
-        found_match = true;
-        solve_data.moves = moves.subAlgorithm(consumed, i + 1);
-        // solve_data is initialized to parity anyway, so no need to update here
-      }
-      if (found_match) {
-        reconstruction.push_back(solve_data);
-        consumed = i + 1;  // we consumed [0, i] which has a length of (i + 1)
-        break;
+      found_match = true;
+      carried_move.reset();
+      if (match->second.cancelled_turn) {
+        const Move cancelled_move =
+            inverse_orientation.apply(Move{*match->second.cancelled_turn});
+        appendMove(alg_moves, cancelled_move);
+        carried_move = cancelled_move.inv();
       }
+      SolveData solve_data{};
+      solve_data.moves = std::move(alg_moves);
+      solve_data.is_parsed = true;
+      solve_data.blindsolving_move = match->second.blindsolving_move;
+      reconstruction.push_back(solve_data);
+      consumed = i + 1;  // we consumed [0, i] which has a length of (i + 1)
+      break;
     }
     if (!found_match) {
       if (reconstruction.empty() || reconstruction.back().is_parsed) {
         reconstruction.emplace_back(Algorithm{});
       }
-      reconstruction.back().moves.push_back(moves[consumed]);
-      consumed++;
+      // slide the start of the next alg forward by one move, starting with
+      // the carried move if there is one
+      if (carried_move) {
+        reconstruction.back().moves.push_back(*carried_move);
+        carried_move.reset();
+      } else {
+        reconstruction.back().moves.push_back(moves[consumed]);
+        consumed++;
+      }
     }
   }
   return reconstruction;
@@ -297,67 +401,404 @@ ReconstructionIterator getReconstructionIterator(Cube cube) {
       first_corner_cycle, corner_cycles, rotation_amounts};
 }
 
-std::vector<std::pair<BlindsolvingReconstruction, size_t>>
-getBestReconstructions(const Reconstruction& solve, ReconstructionIterator& it,
-                       const size_t& max) {
+/**
+ * @return The parsed solve as a BlindsolvingReconstruction, with a sentinel
+ * for each unparsed component.
+ */
+static BlindsolvingReconstruction getBaseline(const Reconstruction& solve) {
   /**
    * Used to mark unparsed components of the parsed solve to differentiate it
    * from parsed components when computing Levenshtein edit distances.
    */
   static constexpr BlindsolvingMove UNPARSED_SENTINEL{true, ' '};
 
-  const size_t period = it.getPeriod();
-  it.reset();  // ensures that all possible reconstructions are checked
+  BlindsolvingReconstruction baseline;
+  for (const SolveData& solve_data : solve) {
+    if (solve_data.is_parsed)
+      baseline.push_back(solve_data.blindsolving_move);
+    else
+      baseline.push_back(UNPARSED_SENTINEL);
+  }
+  return baseline;
+}
 
-  const BlindsolvingReconstruction baseline = [&]() {
-    BlindsolvingReconstruction baseline;
-    for (const SolveData& solve_data : solve) {
-      if (solve_data.is_parsed)
-        baseline.push_back(solve_data.blindsolving_move);
-      else
-        baseline.push_back(UNPARSED_SENTINEL);
+/**
+ * A reconstruction together with its edit distance and its index in the
+ * ReconstructionIterator.
+ */
+struct ScoredReconstruction {
+  BlindsolvingReconstruction reconstruction;
+  size_t edit_distance;
+  size_t index;
+};
+
+/**
+ * Orders by edit distance, breaking ties by index, so that the best
+ * reconstructions do not depend on how the period was split between threads.
+ */
+static bool isBetter(const ScoredReconstruction& first,
+                     const ScoredReconstruction& second) {
+  return first.edit_distance < second.edit_distance ||
+         (first.edit_distance == second.edit_distance &&
+          first.index < second.index);
+}
+
+using ReconstructionEditDistance =
+    utility::BitParallelEditDistance<BlindsolvingMove,
+                                     BlindsolvingMoveAlphabetSize, encode>;
+
+/**
+ * Scores the reconstructions with indices in [begin, end), keeping the best
+ * max of them in a bounded max heap whose top is the worst one kept.
+ * @param it An iterator at the reconstruction with index begin.
+ * @return The best reconstructions in the range, from best to worst.
+ */
+static std::vector<ScoredReconstruction> getBestReconstructionsInRange(
+    const BlindsolvingReconstruction& baseline, ReconstructionIterator it,
+    const size_t& begin, const size_t& end, const size_t& max) {
+  if (max == 0) return {};
+  // solves are almost always short enough for the bit-parallel kernel
+  const std::optional<ReconstructionEditDistance> bit_parallel_edit_distance =
+      baseline.size() <= ReconstructionEditDistance::MaxPatternLength
+          ? std::make_optional<ReconstructionEditDistance>(baseline)
+          : std::nullopt;
+  // reconstructions are scored from a reused buffer, so only the ones that
+  // enter the heap are allocated
+  const bool use_buffer =
+      bit_parallel_edit_distance &&
+      it.getLength() <= ReconstructionIterator::MaxLength;
+  ReconstructionIterator::Buffer buffer;
+  std::vector<ScoredReconstruction> heap;
+  heap.reserve(std::min(end - begin, max) + 1);
+  for (size_t index = begin; index < end; ++index, ++it) {
+    BlindsolvingReconstruction reconstruction;
+    size_t edit_distance;
+    if (use_buffer) {
+      it.writeTo(buffer);
+      edit_distance = (*bit_parallel_edit_distance)(buffer);
+    } else {
+      reconstruction = *it;
+      edit_distance =
+          bit_parallel_edit_distance
+              ? (*bit_parallel_edit_distance)(reconstruction)
+              : utility::levEditDistance(baseline, reconstruction);
     }
-    return baseline;
-  }();
+    // later indices lose ties, so they only replace strictly worse ones
+    if (heap.size() == max && edit_distance >= heap.front().edit_distance)
+      continue;
+    if (use_buffer) reconstruction.assign(buffer.begin(), buffer.end());
+    heap.push_back({std::move(reconstruction), edit_distance, index});
+    std::push_heap(heap.begin(), heap.end(), isBetter);
+    if (heap.size() > max) {
+      std::pop_heap(heap.begin(), heap.end(), isBetter);
+      heap.pop_back();
+    }
+  }
+  std::sort_heap(heap.begin(), heap.end(), isBetter);
+  return heap;
+}
 
-  const auto query_iterator = [&]() {
-    std::pair<BlindsolvingReconstruction, size_t> reconstruction;
-    reconstruction.first = *it;
-    reconstruction.second =
-        utility::levEditDistance(baseline, reconstruction.first);
-    return reconstruction;
-  };
+/**
+ * Finds the same best reconstructions as getBestReconstructionsInRange over
+ * the whole period, but builds the reconstructions cycle by cycle in a depth
+ * first search. Each BlindsolvingMove appended to the prefix adds a row to the
+ * Levenshtein DP against the baseline, which bounds the edit distance of every
+ * reconstruction that starts with the prefix, so subtrees that cannot beat
+ * the worst of the best max reconstructions found so far are skipped. The
+ * index of each reconstruction in the ReconstructionIterator is accumulated
+ * digit by digit, in the same mixed radix as its rank().
+ */
+class ReconstructionSearch {
+ private:
+  const BlindsolvingReconstruction& baseline;
+  const ReconstructionIterator& it;
+  const size_t max;
 
-  std::vector<std::pair<BlindsolvingReconstruction, size_t>>
-      best_reconstructions;
-  for (size_t i = 0; i < std::min(period, max); ++i) {
-    best_reconstructions.push_back(query_iterator());
-    ++it;
+  BlindsolvingReconstruction prefix;
+  // rows[k][m] is the edit distance between the first k moves of prefix and
+  // the first m moves of baseline
+  std::vector<std::vector<size_t>> rows;
+  std::vector<bool> is_edge_cycle_used;
+  std::vector<bool> is_corner_cycle_used;
+  std::vector<ScoredReconstruction> heap;
+
+ public:
+  ReconstructionSearch(const BlindsolvingReconstruction& baseline,
+                       const ReconstructionIterator& it, const size_t& max)
+      : baseline(baseline),
+        it(it),
+        max(max),
+        rows(it.getLength() + 1, std::vector<size_t>(baseline.size() + 1)),
+        is_edge_cycle_used(it.getEdgeIterator().getCycles().size()),
+        is_corner_cycle_used(it.getCornerIterator().getCycles().size()) {
+    prefix.reserve(it.getLength());
+    heap.reserve(max + 1);
+    for (size_t m = 0; m <= baseline.size(); ++m) rows[0][m] = m;
+  }
+
+  std::vector<ScoredReconstruction> search() {
+    if (max == 0) return {};
+    for (const char& edge : it.getFirstEdgeCycle()) pushEdge(edge);
+    searchEdges(0, 0, 0, 1, 0);
+    std::sort_heap(heap.begin(), heap.end(), isBetter);
+    return std::move(heap);
+  }
+
+ private:
+  void push(const BlindsolvingMove& move) {
+    const size_t k = prefix.size();
+    prefix.push_back(move);
+    const std::vector<size_t>& row = rows[k];
+    std::vector<size_t>& next_row = rows[k + 1];
+    next_row[0] = k + 1;
+    for (size_t m = 1; m <= baseline.size(); ++m)
+      next_row[m] =
+          std::min({row[m] + 1, next_row[m - 1] + 1,
+                    row[m - 1] + (move == baseline[m - 1] ? 0 : 1)});
+  }
+
+  void pushEdge(const char& edge) {
+    // odd positions are swapped, like in ReconstructionIterator::operator*
+    push(BlindsolvingMove{
+        true, prefix.size() % 2 == 1
+                  ? ReconstructionIterator::swapIfNecessary(edge)
+                  : edge});
+  }
+
+  void pop(const size_t& count) { prefix.resize(prefix.size() - count); }
+
+  /**
+   * @return Whether some reconstruction starting with prefix could be one of
+   * the best max. The remaining moves of such a reconstruction can at best
+   * match the remaining moves of baseline, except for the difference in their
+   * lengths.
+   */
+  [[nodiscard]] bool canImprove() const {
+    if (heap.size() < max) return true;
+    const size_t k = prefix.size();
+    const size_t remaining = it.getLength() - k;
+    const std::vector<size_t>& row = rows[k];
+    size_t lower_bound = row[baseline.size()] + remaining;
+    for (size_t m = 0; m < baseline.size(); ++m) {
+      const size_t baseline_remaining = baseline.size() - m;
+      const size_t length_difference = remaining > baseline_remaining
+                                           ? remaining - baseline_remaining
+                                           : baseline_remaining - remaining;
+      lower_bound = std::min(lower_bound, row[m] + length_difference);
+    }
+    // ties are kept, since a smaller index wins them
+    return lower_bound <= heap.front().edit_distance;
+  }
+
+  /**
+   * Chooses the edge cycle in the given slot of the CycleSequenceIterator
+   * permutation, along with its counter and whether it is inverted.
+   */
+  void searchEdges(const size_t& slot, const size_t& permutation_rank,
+                   const size_t& counter_rank, const size_t& counter_radix,
+                   const size_t& inversions) {
+    const EdgeCycleSequenceIterator& edge_iterator = it.getEdgeIterator();
+    const std::vector<std::vector<char>>& cycles = edge_iterator.getCycles();
+    if (slot == cycles.size()) {
+      const size_t edge_rank =
+          ((permutation_rank * counter_radix + counter_rank) << cycles.size()) |
+          inversions;
+      const size_t prefix_size = prefix.size();
+      if (it.hasParity()) push(BlindsolvingMove{});
+      for (const char& corner : it.getFirstCornerCycle())
+        push(BlindsolvingMove{false, corner});
+      if (canImprove()) searchCorners(edge_rank, 0, 0, 0, 1, 0);
+      pop(prefix.size() - prefix_size);
+      return;
+    }
+
+    size_t smaller_unused_count = 0;
+    for (size_t c = 0; c < cycles.size(); ++c) {
+      if (is_edge_cycle_used[c]) continue;
+      is_edge_cycle_used[c] = true;
+      const size_t next_permutation_rank =
+          permutation_rank +
+          smaller_unused_count *
+              utility::factorial(cycles.size() - 1 - slot);
+      for (size_t counter = 0; counter < cycles[c].size(); ++counter) {
+        for (const bool is_inverted : {false, true}) {
+          EdgeCycleSequenceIterator::visitCycle(
+              cycles[c], counter, edge_iterator.getAreEven()[c], is_inverted,
+              [&](const char& edge) { pushEdge(edge); });
+          if (canImprove())
+            searchEdges(slot + 1, next_permutation_rank,
+                        counter_rank + counter * counter_radix,
+                        counter_radix * cycles[c].size(),
+                        inversions | (size_t{is_inverted} << slot));
+          pop(cycles[c].size() + 1);
+        }
+      }
+      is_edge_cycle_used[c] = false;
+      ++smaller_unused_count;
+    }
+  }
+
+  /**
+   * Chooses the corner cycle in the given slot of the CycleSequenceIterator
+   * permutation, along with its counter and modification.
+   */
+  void searchCorners(const size_t& edge_rank, const size_t& slot,
+                     const size_t& permutation_rank, const size_t& counter_rank,
+                     const size_t& counter_radix,
+                     const size_t& modification_rank) {
+    const CornerCycleSequenceIterator& corner_iterator = it.getCornerIterator();
+    const std::vector<std::vector<char>>& cycles = corner_iterator.getCycles();
+    if (slot == cycles.size()) {
+      const size_t corner_rank =
+          (permutation_rank * counter_radix + counter_rank) *
+              utility::PowersOf3[cycles.size()] +
+          modification_rank;
+      record(corner_rank * it.getEdgeIterator().getPeriod() + edge_rank);
+      return;
+    }
+
+    size_t smaller_unused_count = 0;
+    for (size_t c = 0; c < cycles.size(); ++c) {
+      if (is_corner_cycle_used[c]) continue;
+      is_corner_cycle_used[c] = true;
+      const size_t next_permutation_rank =
+          permutation_rank +
+          smaller_unused_count *
+              utility::factorial(cycles.size() - 1 - slot);
+      for (size_t counter = 0; counter < cycles[c].size(); ++counter) {
+        for (uint8_t modification = 0; modification < 3; ++modification) {
+          CornerCycleSequenceIterator::visitCycle(
+              cycles[c], counter, corner_iterator.getRotationAmounts()[c],
+              static_cast<CornerRotationAmount>(modification),
+              [&](const char& corner) {
+                push(BlindsolvingMove{false, corner});
+              });
+          if (canImprove())
+            searchCorners(edge_rank, slot + 1, next_permutation_rank,
+                          counter_rank + counter * counter_radix,
+                          counter_radix * cycles[c].size(),
+                          modification_rank +
+                              modification * utility::PowersOf3[slot]);
+          pop(cycles[c].size() + 1);
+        }
+      }
+      is_corner_cycle_used[c] = false;
+      ++smaller_unused_count;
+    }
   }
 
-  const auto comparator =
-      [](const std::pair<BlindsolvingReconstruction, size_t>& first,
-         const std::pair<BlindsolvingReconstruction, size_t>& second) {
-        return first.second < second.second;
-      };
-  std::sort(best_reconstructions.begin(), best_reconstructions.end(),
-            comparator);
-
-  if (period == max) return best_reconstructions;
-
-  do {
-    std::pair<BlindsolvingReconstruction, size_t> reconstruction =
-        query_iterator();
-    const size_t index = std::upper_bound(best_reconstructions.begin(),
-                                          best_reconstructions.end(),
-                                          reconstruction, comparator) -
-                         best_reconstructions.begin();
-    if (index < max) {
-      for (size_t i = max - 1; i > index; i--)
-        best_reconstructions[i] = best_reconstructions[i - 1];
-      best_reconstructions[index] = reconstruction;
+  void record(const size_t& index) {
+    assert(prefix.size() == it.getLength());
+    ScoredReconstruction scored_reconstruction{
+        prefix, rows[prefix.size()][baseline.size()], index};
+    if (heap.size() == max && !isBetter(scored_reconstruction, heap.front()))
+      return;
+    heap.push_back(std::move(scored_reconstruction));
+    std::push_heap(heap.begin(), heap.end(), isBetter);
+    if (heap.size() > max) {
+      std::pop_heap(heap.begin(), heap.end(), isBetter);
+      heap.pop_back();
     }
-  } while (++it);
+  }
+};
+
+static std::vector<std::pair<BlindsolvingReconstruction, size_t>>
+toEditDistancePairs(std::vector<ScoredReconstruction>&& scored) {
+  std::vector<std::pair<BlindsolvingReconstruction, size_t>>
+      best_reconstructions;
+  best_reconstructions.reserve(scored.size());
+  for (ScoredReconstruction& scored_reconstruction : scored)
+    best_reconstructions.emplace_back(
+        std::move(scored_reconstruction.reconstruction),
+        scored_reconstruction.edit_distance);
   return best_reconstructions;
 }
+
+std::vector<std::pair<BlindsolvingReconstruction, size_t>>
+getBestReconstructions(const Reconstruction& solve, ReconstructionIterator& it,
+                       const size_t& max) {
+  it.reset();  // ensures that all possible reconstructions are checked
+  return toEditDistancePairs(getBestReconstructionsInRange(
+      getBaseline(solve), it, 0, it.getPeriod(), max));
+}
+
+std::vector<std::pair<BlindsolvingReconstruction, size_t>>
+getBestReconstructionsParallel(const Reconstruction& solve,
+                               const ReconstructionIterator& it,
+                               const size_t& max,
+                               const size_t& thread_count) {
+  const BlindsolvingReconstruction baseline = getBaseline(solve);
+  const size_t period = it.getPeriod();
+  const size_t chunk_count = std::max(thread_count, size_t{1});
+
+  std::vector<std::vector<ScoredReconstruction>> chunk_results(chunk_count);
+  const auto score_chunk = [&](const size_t& chunk) {
+    const size_t begin = period * chunk / chunk_count;
+    const size_t end = period * (chunk + 1) / chunk_count;
+    if (begin == end) return;
+    ReconstructionIterator chunk_it = it;
+    chunk_it.seek(begin);
+    chunk_results[chunk] =
+        getBestReconstructionsInRange(baseline, chunk_it, begin, end, max);
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(chunk_count - 1);
+  for (size_t chunk = 1; chunk < chunk_count; ++chunk)
+    threads.emplace_back(score_chunk, chunk);
+  score_chunk(0);
+  for (std::thread& thread : threads) thread.join();
+
+  // every reconstruction of the overall best is among the best of its chunk
+  std::vector<ScoredReconstruction> merged;
+  for (std::vector<ScoredReconstruction>& chunk_result : chunk_results)
+    std::move(chunk_result.begin(), chunk_result.end(),
+              std::back_inserter(merged));
+  std::sort(merged.begin(), merged.end(), isBetter);
+  if (merged.size() > max) merged.erase(merged.begin() + max, merged.end());
+  return toEditDistancePairs(std::move(merged));
+}
+
+std::vector<std::pair<BlindsolvingReconstruction, size_t>>
+searchBestReconstructions(const Reconstruction& solve,
+                          const ReconstructionIterator& it,
+                          const size_t& max) {
+  return toEditDistancePairs(
+      ReconstructionSearch{getBaseline(solve), it, max}.search());
+}
+
+// Test functions
+
+/**
+ * R U and R F are both R one Turn short, so R can't be matched to either of
+ * them unless it is an alg itself.
+ */
+static void testAmbiguousCancelledMatches() {
+  const BlindsolvingMove first{true, 'A'};
+  const BlindsolvingMove second{true, 'B'};
+  std::vector<std::pair<BlindsolvingMove, Algorithm>> algs{
+      {first, Algorithm::parse("R U")}, {second, Algorithm::parse("R F")}};
+  const Cube ambiguous_cube{Algorithm::parse("R")};
+
+  const std::unordered_map<Cube, AlgMatch> alg_matches = getAlgMatches(algs);
+  if (alg_matches.contains(ambiguous_cube))
+    throw std::logic_error("Matched an ambiguous cancelled Cube!");
+  const auto match = alg_matches.find(Cube{Algorithm::parse("R U2")});
+  if (match == alg_matches.end() || match->second.blindsolving_move != first ||
+      match->second.cancelled_turn !=
+          Turn{Face::U, RotationAmount::Counterclockwise})
+    throw std::logic_error("Did not match an unambiguous cancelled Cube!");
+
+  const BlindsolvingMove third{true, 'C'};
+  algs.emplace_back(third, Algorithm::parse("R"));
+  const std::unordered_map<Cube, AlgMatch> exact_matches =
+      getAlgMatches(algs);
+  const auto exact_match = exact_matches.find(ambiguous_cube);
+  if (exact_match == exact_matches.end() ||
+      exact_match->second.blindsolving_move != third ||
+      exact_match->second.cancelled_turn)
+    throw std::logic_error("Did not prefer an exact match!");
+}
+
+void runBlindsolvingTests() { testAmbiguousCancelledMatches(); }
 }  // namespace blindsolving
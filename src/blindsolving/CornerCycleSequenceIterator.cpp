@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <cstddef>
 #include <utility>
 #include <vector>
 
@@ -30,53 +31,19 @@ bool CornerCycleSequenceIterator::operator++() {
 }
 
 std::vector<char> CornerCycleSequenceIterator::operator*() const {
-  std::vector<std::vector<char>> current = *it;
+  std::vector<char> targets;
+  visit([&](const char& target) { targets.push_back(target); });
+  return targets;
+}
 
-  // add the final cycle-closing targets
-  const std::vector<size_t>& counters = it.getCounters();
-  const std::vector<size_t>& permutation = it.getPermutation();
-  for (size_t i = 0; i < current.size(); i++) {
-    switch (rotation_amounts[permutation[i]]) {
-      case CornerRotationAmount::None:
-        // just add the final cycle-closing target
-        current[i].push_back(current[i][0]);
-        break;
-      case CornerRotationAmount::Clockwise:
-        // rotate the last counters[permutations[i]] elements clockwise (which
-        // wrap around to the end)
-        for (size_t j = current[i].size() - counters[permutation[i]];
-             j < current[i].size(); j++)
-          current[i][j] = rotateClockwise(current[i][j]);
-        // add the final cycle-closing target
-        current[i].push_back(rotateClockwise(current[i][0]));
-        break;
-      case CornerRotationAmount::Counterclockwise:
-        // rotate the last counters[permutations[i]] elements counterclockwise
-        // (which wrap around to the end)
-        for (size_t j = current[i].size() - counters[permutation[i]];
-             j < current[i].size(); j++)
-          current[i][j] = rotateCounterclockwise(current[i][j]);
-        // add the final cycle-closing target
-        current[i].push_back(rotateCounterclockwise(current[i][0]));
-        break;
-      default:
-        throw std::logic_error("Unknown enum value!");
-    }
-  }
-  // modify the correct cycles
-  for (size_t i = 0; i < modifications.size(); i++) {
-    switch (modifications[i]) {
-      case CornerRotationAmount::None:
-        break;
-      case CornerRotationAmount::Clockwise:
-        for (char& c : current[i]) c = rotateClockwise(c);
-        break;
-      case CornerRotationAmount::Counterclockwise:
-        for (char& c : current[i]) c = rotateCounterclockwise(c);
-        break;
-    }
-  }
-  return utility::flatten(current);
+const std::vector<std::vector<char>>& CornerCycleSequenceIterator::getCycles()
+    const {
+  return it.getCycles();
+}
+
+const std::vector<CornerRotationAmount>&
+CornerCycleSequenceIterator::getRotationAmounts() const {
+  return rotation_amounts;
 }
 
 size_t CornerCycleSequenceIterator::getPeriod() const {
@@ -89,4 +56,22 @@ void CornerCycleSequenceIterator::reset() {
   std::fill(modifications.begin(), modifications.end(),
             CornerRotationAmount::None);
 }
+
+void CornerCycleSequenceIterator::seek(const size_t& index) {
+  // the modifications are the least significant digits, in base 3
+  assert(modifications.size() < utility::PowersOf3.size());
+  it.seek(index / utility::PowersOf3[modifications.size()]);
+  for (size_t i = 0; i < modifications.size(); i++)
+    modifications[i] = static_cast<CornerRotationAmount>(
+        (index / utility::PowersOf3[i]) % 3);
+}
+
+size_t CornerCycleSequenceIterator::rank() const {
+  size_t modification_rank = 0;
+  for (size_t i = 0; i < modifications.size(); i++)
+    modification_rank +=
+        static_cast<size_t>(modifications[i]) * utility::PowersOf3[i];
+  return it.rank() * utility::PowersOf3[modifications.size()] +
+         modification_rank;
+}
 }  // namespace blindsolving
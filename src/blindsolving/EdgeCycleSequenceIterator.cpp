@@ -1,7 +1,7 @@
 #include "EdgeCycleSequenceIterator.h"
 #include "Lettering.h"
-#include "Utils.h"
 #include <algorithm>
+#include <cstddef>
 #include <utility>
 #include <vector>
 
@@ -27,30 +27,18 @@ bool EdgeCycleSequenceIterator::operator++() {
 }
 
 std::vector<char> EdgeCycleSequenceIterator::operator*() const {
-  std::vector<std::vector<char>> current = *it;
+  std::vector<char> targets;
+  visit([&](const char& target) { targets.push_back(target); });
+  return targets;
+}
 
-  // perform modifications
-  const std::vector<size_t>& counters = it.getCounters();
-  const std::vector<size_t>& permutation = it.getPermutation();
-  for (size_t i = 0; i < current.size(); i++) {
-    if (are_even[permutation[i]])
-      // just add the final cycle-closing target
-      current[i].push_back(current[i][0]);
-    else {
-      // invert the last counters[permutations[i]] elements (which wrap around
-      // to the end)
-      for (size_t j = current[i].size() - counters[permutation[i]];
-           j < current[i].size(); j++)
-        current[i][j] = flipEdge(current[i][j]);
-      // add the final cycle-closing target
-      current[i].push_back(flipEdge(current[i][0]));
-    }
-  }
-  // invert the correct cycles
-  for (size_t i = 0; i < are_inverted.size(); i++)
-    if (are_inverted[i])
-      for (char& c : current[i]) c = flipEdge(c);
-  return utility::flatten(current);
+const std::vector<std::vector<char>>& EdgeCycleSequenceIterator::getCycles()
+    const {
+  return it.getCycles();
+}
+
+const std::vector<bool>& EdgeCycleSequenceIterator::getAreEven() const {
+  return are_even;
 }
 
 size_t EdgeCycleSequenceIterator::getPeriod() const {
@@ -62,4 +50,18 @@ void EdgeCycleSequenceIterator::reset() {
   it.reset();
   std::fill(are_inverted.begin(), are_inverted.end(), false);
 }
+
+void EdgeCycleSequenceIterator::seek(const size_t& index) {
+  // the inversions are the least significant digits, in base 2
+  it.seek(index >> are_inverted.size());
+  for (size_t i = 0; i < are_inverted.size(); i++)
+    are_inverted[i] = (index >> i) & 1;
+}
+
+size_t EdgeCycleSequenceIterator::rank() const {
+  size_t inversions = 0;
+  for (size_t i = 0; i < are_inverted.size(); i++)
+    if (are_inverted[i]) inversions |= size_t{1} << i;
+  return (it.rank() << are_inverted.size()) | inversions;
+}
 }  // namespace blindsolving
@@ -1,5 +1,7 @@
 #include "ReconstructionIterator.h"
 #include "BlindsolvingReconstruction.h"
+#include <cassert>
+#include <cstddef>
 
 namespace blindsolving {
 static size_t calculateLength(
@@ -45,7 +47,7 @@ bool ReconstructionIterator::operator++() {
   return ++edge_iterator || ++corner_iterator;
 }
 
-static char swapIfNecessary(const char& chr) {
+char ReconstructionIterator::swapIfNecessary(const char& chr) {
   switch (chr) {
     case 'C':
       return 'W';
@@ -63,21 +65,38 @@ static char swapIfNecessary(const char& chr) {
 BlindsolvingReconstruction ReconstructionIterator::operator*() const {
   BlindsolvingReconstruction reconstruction;
   reconstruction.reserve(length);
-  for (const char& edge : first_edge_cycle)
-    reconstruction.emplace_back(true, edge);
-  const std::vector<char> edge_moves = *edge_iterator;
-  for (const char& edge : edge_moves) reconstruction.emplace_back(true, edge);
-  for (size_t i = 1; i < reconstruction.size(); i += 2)
-    reconstruction[i].alg = swapIfNecessary(reconstruction[i].alg);
-  if (has_parity) reconstruction.emplace_back();
-  for (const char& corner : first_corner_cycle)
-    reconstruction.emplace_back(false, corner);
-  std::vector<char> corner_moves = *corner_iterator;
-  for (const char& corner : corner_moves)
-    reconstruction.emplace_back(false, corner);
+  visit([&](const BlindsolvingMove& move) { reconstruction.push_back(move); });
   return reconstruction;
 }
 
+void ReconstructionIterator::writeTo(Buffer& buffer) const {
+  assert(length <= MaxLength);
+  buffer.clear();
+  visit([&](const BlindsolvingMove& move) { buffer.push_back(move); });
+}
+
+const std::vector<char>& ReconstructionIterator::getFirstEdgeCycle() const {
+  return first_edge_cycle;
+}
+
+const EdgeCycleSequenceIterator& ReconstructionIterator::getEdgeIterator()
+    const {
+  return edge_iterator;
+}
+
+bool ReconstructionIterator::hasParity() const { return has_parity; }
+
+const std::vector<char>& ReconstructionIterator::getFirstCornerCycle() const {
+  return first_corner_cycle;
+}
+
+const CornerCycleSequenceIterator& ReconstructionIterator::getCornerIterator()
+    const {
+  return corner_iterator;
+}
+
+size_t ReconstructionIterator::getLength() const { return length; }
+
 size_t ReconstructionIterator::getPeriod() const {
   return edge_iterator.getPeriod() * corner_iterator.getPeriod();
 }
@@ -86,4 +105,17 @@ void ReconstructionIterator::reset() {
   edge_iterator.reset();
   corner_iterator.reset();
 }
+
+void ReconstructionIterator::seek(const size_t& index) {
+  // the edges are incremented first, so they are the least significant part
+  assert(index < getPeriod());
+  const size_t edge_period = edge_iterator.getPeriod();
+  edge_iterator.seek(index % edge_period);
+  corner_iterator.seek(index / edge_period);
+}
+
+size_t ReconstructionIterator::rank() const {
+  return corner_iterator.rank() * edge_iterator.getPeriod() +
+         edge_iterator.rank();
+}
 }  // namespace blindsolving
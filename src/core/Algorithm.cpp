@@ -6,7 +6,10 @@
 #include "SliceTurn.h"
 #include "Turn.h"
 #include "WideTurn.h"
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <string_view>
 #include <tuple>
 
 std::string Algorithm::toStr() const {
@@ -98,7 +101,7 @@ bool Algorithm::isStandardForm() const {
   return true;
 }
 
-static size_t consumeSeparators(const std::string& alg) {
+static size_t consumeSeparators(std::string_view alg) {
   size_t consumed = 0;
   while (consumed < alg.size()) {
     switch (alg[consumed]) {
@@ -118,20 +121,28 @@ static size_t consumeSeparators(const std::string& alg) {
   return consumed;  // consumed entire alg
 }
 
-Algorithm Algorithm::parse(const std::string& alg) {
-  size_t total_consumed = 0;
-  const auto get_remaining_alg = [&]() {
-    return alg.substr(total_consumed, alg.size() - total_consumed);
-  };
+static bool isLetter(const char& chr) {
+  return (chr >= 'A' && chr <= 'Z') || (chr >= 'a' && chr <= 'z');
+}
+
+/**
+ * @return An upper bound on the number of Moves that parse can find in alg,
+ * since every Move starts with a letter. It is cheap enough to compute up
+ * front so that parsing does not reallocate.
+ */
+static size_t countMoveCharacters(std::string_view alg) {
+  return std::count_if(alg.begin(), alg.end(), isLetter);
+}
+
+Algorithm Algorithm::parse(std::string_view alg) {
   Algorithm moves{};
-  while (total_consumed < alg.size()) {
-    total_consumed += consumeSeparators(get_remaining_alg());
-    const auto [consumed_for_move, move] = Move::parse(get_remaining_alg());
-    if (consumed_for_move != 0) {
-      moves.push_back(move);
-      total_consumed += consumed_for_move;
-    } else
-      break;
+  moves.reserve(countMoveCharacters(alg));
+  while (!alg.empty()) {
+    alg.remove_prefix(consumeSeparators(alg));
+    const auto [consumed_for_move, move] = Move::parse(alg);
+    if (consumed_for_move == 0) break;
+    moves.push_back(move);
+    alg.remove_prefix(consumed_for_move);
   }
   return moves;
 }
@@ -141,7 +152,7 @@ Algorithm Algorithm::parse(const std::string& alg) {
  * is clockwise, number of rotations)
  */
 static std::tuple<size_t, bool, size_t> parseExpandedRotationAmount(
-    const std::string& str) {
+    std::string_view str) {
   size_t consumed = 0;
   bool clockwise = true;
   size_t rotation_amount = 0;
@@ -160,16 +171,29 @@ static std::tuple<size_t, bool, size_t> parseExpandedRotationAmount(
   return {consumed, clockwise, rotation_amount == 0 ? 1 : rotation_amount};
 }
 
+/**
+ * @return An upper bound on the number of Moves that parseExpanded can find in
+ * alg. Every Move ends with a letter followed by the number of times that it
+ * is repeated, so each letter is counted that many times.
+ */
+static size_t countExpandedMoves(std::string_view alg) {
+  size_t count = 0;
+  for (size_t i = 0; i < alg.size(); ++i)
+    if (isLetter(alg[i]))
+      count += std::get<2>(parseExpandedRotationAmount(alg.substr(i + 1)));
+  return count;
+}
+
 /**
  * @return Tuple of (number of characters consumed, the Move, the number of
  * times the Move should be repeated)
  */
 static std::tuple<size_t, Move, size_t> parseExpandedMove(
-    const std::string& str) {
+    std::string_view str) {
   size_t consumed;
 
   const auto finisher = [&](RotationAmount& rotation_amount) {
-    const std::string remaining = str.substr(consumed, str.size() - consumed);
+    const std::string_view remaining = str.substr(consumed);
     const auto [consumed_for_rotation_amount, clockwise, iterations] =
         parseExpandedRotationAmount(remaining);
     consumed += consumed_for_rotation_amount;
@@ -212,19 +236,15 @@ static std::tuple<size_t, Move, size_t> parseExpandedMove(
   return {0, {}, 0};  // not possible to parse
 }
 
-Algorithm Algorithm::parseExpanded(const std::string& alg) {
-  size_t total_consumed = 0;
-  const auto get_remaining_alg = [&]() {
-    return alg.substr(total_consumed, alg.size() - total_consumed);
-  };
+Algorithm Algorithm::parseExpanded(std::string_view alg) {
   Algorithm moves;
-  while (total_consumed < alg.size()) {
-    total_consumed += consumeSeparators(get_remaining_alg());
-    const auto [consumed_for_move, move, iterations] =
-        parseExpandedMove(get_remaining_alg());
+  moves.reserve(countExpandedMoves(alg));
+  while (!alg.empty()) {
+    alg.remove_prefix(consumeSeparators(alg));
+    const auto [consumed_for_move, move, iterations] = parseExpandedMove(alg);
     if (consumed_for_move == 0) break;
     for (size_t i = 0; i < iterations; i++) moves.push_back(move);
-    total_consumed += consumed_for_move;
+    alg.remove_prefix(consumed_for_move);
   }
   return moves;
 }
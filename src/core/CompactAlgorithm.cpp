@@ -0,0 +1,43 @@
+#include "CompactAlgorithm.h"
+#include "Algorithm.h"
+#include "CompactMove.h"
+#include "Move.h"
+#include "RotationAmount.h"
+#include <algorithm>
+#include <cstddef>
+
+CompactAlgorithm::CompactAlgorithm(const Algorithm& algorithm) {
+  reserve(algorithm.size());
+  for (const Move& move : algorithm) emplace_back(move);
+}
+
+Algorithm CompactAlgorithm::toAlgorithm() const {
+  Algorithm algorithm{size()};
+  std::transform(begin(), end(), algorithm.begin(),
+                 [](const CompactMove& move) { return move.toMove(); });
+  return algorithm;
+}
+
+CompactAlgorithm CompactAlgorithm::inv() const {
+  CompactAlgorithm inverse;
+  inverse.resize(size());
+  std::transform(rbegin(), rend(), inverse.begin(),
+                 [](const CompactMove& move) { return move.inv(); });
+  return inverse;
+}
+
+void CompactAlgorithm::cancelMoves() {
+  // the moves before kept are already fully cancelled, so each move only needs
+  // to be merged with the last of them
+  size_t kept = 0;
+  for (const CompactMove& move : *this) {
+    if (kept > 0 && (*this)[kept - 1].isSameLayer(move)) {
+      CompactMove& last = (*this)[kept - 1];
+      last.setRotationAmount(last.getRotationAmount() +
+                             move.getRotationAmount());
+      if (last.getRotationAmount() == RotationAmount::None) --kept;
+    } else if (move.getRotationAmount() != RotationAmount::None)
+      (*this)[kept++] = move;
+  }
+  resize(kept);
+}
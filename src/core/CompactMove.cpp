@@ -0,0 +1,32 @@
+#include "CompactMove.h"
+#include "Move.h"
+#include <cassert>
+#include <stdexcept>
+
+CompactMove::CompactMove(const Move& move) {
+  if (move.isTurn())
+    *this = CompactMove{move.getTurn()};
+  else if (move.isSliceTurn())
+    *this = CompactMove{move.getSliceTurn()};
+  else if (move.isWideTurn())
+    *this = CompactMove{move.getWideTurn()};
+  else {
+    assert(move.isCubeRotation());
+    *this = CompactMove{move.getCubeRotation()};
+  }
+}
+
+Move CompactMove::toMove() const {
+  switch (getType()) {
+    case Type::Turn:
+      return Move{getTurn()};
+    case Type::SliceTurn:
+      return Move{getSliceTurn()};
+    case Type::WideTurn:
+      return Move{getWideTurn()};
+    case Type::CubeRotation:
+      return Move{getCubeRotation()};
+    default:
+      throw std::logic_error("Unknown enum value!");
+  }
+}
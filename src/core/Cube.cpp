@@ -1,4 +1,5 @@
 #include "Cube.h"
+#include "CubieCube.h"
 #include "Permutation.h"
 #include "RandomUtils.h"
 #include <array>
@@ -8,113 +9,42 @@
 #include <string>
 
 EdgePieceProxy Cube::operator[](const EdgeLocation& edge_location) {
-  const EdgeLocation flipped_location = edge_location.flip();
-  for (size_t i = 0; i < EdgeLocationOrder.size(); ++i) {
-    if (EdgeLocationOrder[i] == edge_location) return {edges[i], false};
-    if (EdgeLocationOrder[i] == flipped_location) return {edges[i], true};
-  }
-  throw std::invalid_argument("EdgeLocation not found!");
+  const auto [index, is_flipped] = getEdgeSlot(edge_location);
+  return {edges[index], is_flipped};
 }
 
 ConstEdgePieceProxy Cube::operator[](const EdgeLocation& edge_location) const {
-  const EdgeLocation flipped_location = edge_location.flip();
-  for (size_t i = 0; i < EdgeLocationOrder.size(); ++i) {
-    if (EdgeLocationOrder[i] == edge_location) return {edges[i], false};
-    if (EdgeLocationOrder[i] == flipped_location) return {edges[i], true};
-  }
-  throw std::invalid_argument("EdgeLocation not found!");
+  const auto [index, is_flipped] = getEdgeSlot(edge_location);
+  return {edges[index], is_flipped};
 }
 
 CornerPieceProxy Cube::operator[](const CornerLocation& corner_location) {
-  const CornerLocation clockwise_location = corner_location.rotateClockwise();
-  const CornerLocation counterclockwise_location =
-      corner_location.rotateCounterclockwise();
-  for (size_t i = 0; i < CornerLocationOrder.size(); ++i) {
-    if (CornerLocationOrder[i] == corner_location)
-      return {corners[i], CornerRotationAmount::None};
-    // rotate the resulting CornerPieceProxy in the opposite direction
-    if (CornerLocationOrder[i] == clockwise_location)
-      return {corners[i], CornerRotationAmount::Counterclockwise};
-    if (CornerLocationOrder[i] == counterclockwise_location)
-      return {corners[i], CornerRotationAmount::Clockwise};
-  }
-  throw std::invalid_argument("CornerLocation not found!");
+  const auto [index, rotation_amount] = getCornerSlot(corner_location);
+  return {corners[index], rotation_amount};
 }
 
 ConstCornerPieceProxy Cube::operator[](
     const CornerLocation& corner_location) const {
-  const CornerLocation clockwise_location = corner_location.rotateClockwise();
-  const CornerLocation counterclockwise_location =
-      corner_location.rotateCounterclockwise();
-  for (size_t i = 0; i < CornerLocationOrder.size(); ++i) {
-    if (CornerLocationOrder[i] == corner_location)
-      return {corners[i], CornerRotationAmount::None};
-    // rotate the resulting ConstCornerPieceProxy in the opposite direction
-    if (CornerLocationOrder[i] == clockwise_location)
-      return {corners[i], CornerRotationAmount::Counterclockwise};
-    if (CornerLocationOrder[i] == counterclockwise_location)
-      return {corners[i], CornerRotationAmount::Clockwise};
-  }
-  throw std::invalid_argument("CornerLocation not found!");
+  const auto [index, rotation_amount] = getCornerSlot(corner_location);
+  return {corners[index], rotation_amount};
 }
 
 void Cube::apply(const Turn& turn) {
   if (turn.rotation_amount == RotationAmount::None) return;
 
-  std::array<EdgeLocation, 4> edge_cycle{};
-  std::array<CornerLocation, 4> corner_cycle{};
+  const TurnTable& table =
+      TurnTables[getTurnTableIndex(orientation.apply(turn))];
 
-  using enum Face;
-  switch (orientation.apply(turn.face)) {
-    case U:
-      edge_cycle = {{{U, B}, {U, R}, {U, F}, {U, L}}};
-      corner_cycle = {{{U, L, B}, {U, B, R}, {U, R, F}, {U, F, L}}};
-      break;
-    case F:
-      edge_cycle = {{{F, U}, {F, R}, {F, D}, {F, L}}};
-      corner_cycle = {{{F, L, U}, {F, U, R}, {F, R, D}, {F, D, L}}};
-      break;
-    case R:
-      edge_cycle = {{{R, U}, {R, B}, {R, D}, {R, F}}};
-      corner_cycle = {{{R, F, U}, {R, U, B}, {R, B, D}, {R, D, F}}};
-      break;
-    case B:
-      edge_cycle = {{{B, U}, {B, L}, {B, D}, {B, R}}};
-      corner_cycle = {{{B, R, U}, {B, U, L}, {B, L, D}, {B, D, R}}};
-      break;
-    case L:
-      edge_cycle = {{{L, U}, {L, F}, {L, D}, {L, B}}};
-      corner_cycle = {{{L, B, U}, {L, U, F}, {L, F, D}, {L, D, B}}};
-      break;
-    case D:
-      edge_cycle = {{{D, F}, {D, R}, {D, B}, {D, L}}};
-      corner_cycle = {{{D, L, F}, {D, F, R}, {D, R, B}, {D, B, L}}};
-      break;
-    default:
-      throw std::logic_error("Unknown enum value!");
-  }
-  switch (turn.rotation_amount) {
-    case RotationAmount::Clockwise:
-      cycleEdges<4>(
-          {edge_cycle[0], edge_cycle[1], edge_cycle[2], edge_cycle[3]});
-      cycleCorners<4>(
-          {corner_cycle[0], corner_cycle[1], corner_cycle[2], corner_cycle[3]});
-      break;
-    case RotationAmount::Counterclockwise:
-      cycleEdges<4>(
-          {edge_cycle[3], edge_cycle[2], edge_cycle[1], edge_cycle[0]});
-      cycleCorners<4>(
-          {corner_cycle[3], corner_cycle[2], corner_cycle[1], corner_cycle[0]});
-      break;
-    case RotationAmount::HalfTurn:
-      cycleEdges<2>({edge_cycle[0], edge_cycle[2]});
-      cycleEdges<2>({edge_cycle[1], edge_cycle[3]});
-      cycleCorners<2>({corner_cycle[0], corner_cycle[2]});
-      cycleCorners<2>({corner_cycle[1], corner_cycle[3]});
-      break;
-    case RotationAmount::None:
-      throw std::logic_error("turn.rotation_amount became None!");
+  const std::array<EdgePiece, 12> old_edges = edges;
+  for (size_t i = 0; i < edges.size(); ++i) {
+    const EdgePiece& edge = old_edges[table.edge_sources[i]];
+    edges[i] = table.edge_flips[i] ? edge.flip() : edge;
   }
+
+  const std::array<CornerPiece, 8> old_corners = corners;
+  for (size_t i = 0; i < corners.size(); ++i)
+    corners[i] = old_corners[table.corner_sources[i]].rotate(
+        static_cast<CornerRotationAmount>(table.corner_rotations[i]));
 }
 
 void Cube::apply(const SliceTurn& slice_turn) {
@@ -152,6 +82,29 @@ void Cube::apply(const Algorithm& algorithm) {
   for (const Move& move : algorithm) apply(move);
 }
 
+void Cube::apply(const CompactMove& move) {
+  switch (move.getType()) {
+    case CompactMove::Type::Turn:
+      apply(move.getTurn());
+      break;
+    case CompactMove::Type::SliceTurn:
+      apply(move.getSliceTurn());
+      break;
+    case CompactMove::Type::WideTurn:
+      apply(move.getWideTurn());
+      break;
+    case CompactMove::Type::CubeRotation:
+      apply(move.getCubeRotation());
+      break;
+    default:
+      throw std::logic_error("Unknown enum value!");
+  }
+}
+
+void Cube::apply(const CompactAlgorithm& algorithm) {
+  for (const CompactMove& move : algorithm) apply(move);
+}
+
 void Cube::scramble() {
   const auto edge_permutation =
       Permutation<EdgeLocationOrder.size()>::randomPermutation();
@@ -0,0 +1,136 @@
+#include "CubeBatch.h"
+#include "Algorithm.h"
+#include "Cube.h"
+#include "CubeOrientation.h"
+#include "CubeRotation.h"
+#include "CubieCube.h"
+#include "Move.h"
+#include "RotationAmount.h"
+#include "SliceTurn.h"
+#include "Turn.h"
+#include "WideTurn.h"
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+CubeBatch::CubeBatch(const size_t& count)
+    : orientation(CubeOrientation::identity()), count(count) {
+  static constexpr CubieCube Solved{};
+  for (size_t i = 0; i < edges.size(); ++i)
+    edges[i].assign(count, Solved.getEdges()[i]);
+  for (size_t i = 0; i < corners.size(); ++i)
+    corners[i].assign(count, Solved.getCorners()[i]);
+}
+
+CubeBatch::CubeBatch(const std::vector<Cube>& cubes)
+    : orientation(cubes.empty() ? CubeOrientation::identity()
+                                : cubes.front().getOrientation()),
+      count(cubes.size()) {
+  for (std::vector<uint8_t>& slot : edges) slot.resize(count);
+  for (std::vector<uint8_t>& slot : corners) slot.resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    if (cubes[i].getOrientation() != orientation)
+      throw std::invalid_argument(
+          "All Cubes in a CubeBatch must have the same CubeOrientation!");
+    const CubieCube cubie_cube{cubes[i]};
+    for (size_t j = 0; j < edges.size(); ++j)
+      edges[j][i] = cubie_cube.getEdges()[j];
+    for (size_t j = 0; j < corners.size(); ++j)
+      corners[j][i] = cubie_cube.getCorners()[j];
+  }
+}
+
+void CubeBatch::apply(const Turn& turn) {
+  if (turn.rotation_amount == RotationAmount::None) return;
+  const TurnTable& table =
+      TurnTables[getTurnTableIndex(orientation.apply(turn))];
+
+  // moving the slot vectors only swaps pointers, so permuting the pieces is
+  // independent of the number of Cubes
+  auto old_edges = std::move(edges);
+  for (size_t i = 0; i < edges.size(); ++i) {
+    edges[i] = std::move(old_edges[table.edge_sources[i]]);
+    if (table.edge_flips[i] == 0) continue;
+    for (uint8_t& edge : edges[i]) edge ^= 1;
+  }
+
+  auto old_corners = std::move(corners);
+  for (size_t i = 0; i < corners.size(); ++i) {
+    corners[i] = std::move(old_corners[table.corner_sources[i]]);
+    const uint8_t rotation = table.corner_rotations[i];
+    if (rotation == 0) continue;
+    for (uint8_t& corner : corners[i]) {
+      // the rotations are at most 2 + 2 = 4, so they never carry into the piece
+      corner += rotation;
+      corner -= (corner & CubieCube::OrientationMask) >= 3 ? 3 : 0;
+    }
+  }
+}
+
+void CubeBatch::apply(const SliceTurn& slice_turn) {
+  const auto [turn1, turn2, cube_rotation] = slice_turn.expand();
+  apply(turn1);
+  apply(turn2);
+  apply(cube_rotation);
+}
+
+void CubeBatch::apply(const WideTurn& wide_turn) {
+  const auto [turn, cube_rotation] = wide_turn.expand();
+  apply(turn);
+  apply(cube_rotation);
+}
+
+void CubeBatch::apply(const CubeRotation& cube_rotation) {
+  orientation *= cube_rotation;
+}
+
+void CubeBatch::apply(const Move& move) {
+  if (move.isTurn())
+    apply(move.getTurn());
+  else if (move.isSliceTurn())
+    apply(move.getSliceTurn());
+  else if (move.isWideTurn())
+    apply(move.getWideTurn());
+  else {
+    assert(move.isCubeRotation());
+    apply(move.getCubeRotation());
+  }
+}
+
+void CubeBatch::apply(const Algorithm& algorithm) {
+  for (const Move& move : algorithm) apply(move);
+}
+
+std::vector<bool> CubeBatch::isSolved() const {
+  static constexpr CubieCube Solved{};
+  // accumulate into bytes rather than bools so that the loops vectorize
+  std::vector<uint8_t> mismatches(count, 0);
+  for (size_t i = 0; i < edges.size(); ++i) {
+    const uint8_t solved_edge = Solved.getEdges()[i];
+    for (size_t j = 0; j < count; ++j)
+      mismatches[j] |= edges[i][j] ^ solved_edge;
+  }
+  for (size_t i = 0; i < corners.size(); ++i) {
+    const uint8_t solved_corner = Solved.getCorners()[i];
+    for (size_t j = 0; j < count; ++j)
+      mismatches[j] |= corners[i][j] ^ solved_corner;
+  }
+
+  std::vector<bool> is_solved(count);
+  for (size_t j = 0; j < count; ++j) is_solved[j] = mismatches[j] == 0;
+  return is_solved;
+}
+
+CubieCube CubeBatch::operator[](const size_t& idx) const {
+  assert(idx < count);
+  std::array<uint8_t, 16> cube_edges{};
+  std::array<uint8_t, 8> cube_corners{};
+  for (size_t i = 0; i < edges.size(); ++i) cube_edges[i] = edges[i][idx];
+  for (size_t i = 0; i < corners.size(); ++i)
+    cube_corners[i] = corners[i][idx];
+  return {cube_edges, cube_corners};
+}
@@ -12,22 +12,6 @@
 #include <optional>
 #include <stdexcept>
 
-bool CubeOrientation::isValid() const {
-  return top != front && top != getOpposite(front);
-}
-
-bool CubeOrientation::operator==(const CubeOrientation& other) const {
-  return top == other.top && front == other.front;
-}
-
-Face CubeOrientation::getRightFace() const { return getRight(top, front); }
-
-Face CubeOrientation::getBackFace() const { return getOpposite(front); }
-
-Face CubeOrientation::getLeftFace() const { return getLeft(top, front); }
-
-Face CubeOrientation::getBottomFace() const { return getOpposite(top); }
-
 CubeOrientation CubeOrientation::random() {
   const uint8_t seed = utility::randomInt<24>();
   const Face top = static_cast<Face>(seed % 6);
@@ -155,33 +139,10 @@ CubeOrientation::solve() const {
   return {first, second};
 }
 
-Face CubeOrientation::apply(const Face& face) const {
-  switch (face) {
-    case Face::U:
-      return top;
-    case Face::F:
-      return front;
-    case Face::R:
-      return getRightFace();
-    case Face::B:
-      return getBackFace();
-    case Face::L:
-      return getLeftFace();
-    case Face::D:
-      return getBottomFace();
-    default:
-      throw std::logic_error("Unknown enum value!");
-  }
-}
-
 std::pair<Slice, bool> CubeOrientation::apply(const Slice& slice) const {
   return fromRotationFace(apply(getRotationFace(slice)));
 }
 
-Turn CubeOrientation::apply(const Turn& turn) const {
-  return Turn{apply(turn.face), turn.rotation_amount};
-}
-
 SliceTurn CubeOrientation::apply(const SliceTurn& slice_turn) const {
   const auto [new_slice, reversed] = apply(slice_turn.slice);
   return SliceTurn{new_slice, reversed ? -slice_turn.rotation_amount
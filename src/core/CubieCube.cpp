@@ -0,0 +1,134 @@
+#include "CubieCube.h"
+#include "Colour.h"
+#include "CornerPiece.h"
+#include "CornerRotationAmount.h"
+#include "Cube.h"
+#include "EdgePiece.h"
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+static constexpr uint8_t UnknownPiece = 0xFF;
+
+/**
+ * Maps the colours of an EdgePiece (first, second) to its CubieCube byte.
+ */
+static consteval std::array<std::array<uint8_t, 6>, 6> getEdgeBytes() {
+  std::array<std::array<uint8_t, 6>, 6> edge_bytes{};
+  for (auto& row : edge_bytes) row.fill(UnknownPiece);
+  for (uint8_t i = 0; i < Cube::StartingEdgePieces.size(); ++i) {
+    const EdgePiece& piece = Cube::StartingEdgePieces[i];
+    edge_bytes[static_cast<uint8_t>(piece.first)]
+              [static_cast<uint8_t>(piece.second)] = i << 4;
+    edge_bytes[static_cast<uint8_t>(piece.second)]
+              [static_cast<uint8_t>(piece.first)] = (i << 4) | 1;
+  }
+  return edge_bytes;
+}
+
+/**
+ * Maps the first two colours of a CornerPiece (which uniquely determine the
+ * third) to its CubieCube byte.
+ */
+static consteval std::array<std::array<uint8_t, 6>, 6> getCornerBytes() {
+  std::array<std::array<uint8_t, 6>, 6> corner_bytes{};
+  for (auto& row : corner_bytes) row.fill(UnknownPiece);
+  for (uint8_t i = 0; i < Cube::StartingCornerPieces.size(); ++i) {
+    for (const CornerRotationAmount& rotation_amount :
+         {CornerRotationAmount::None, CornerRotationAmount::Clockwise,
+          CornerRotationAmount::Counterclockwise}) {
+      const CornerPiece piece =
+          Cube::StartingCornerPieces[i].rotate(rotation_amount);
+      corner_bytes[static_cast<uint8_t>(piece.first)]
+                  [static_cast<uint8_t>(piece.second)] =
+                      (i << 4) | static_cast<uint8_t>(rotation_amount);
+    }
+  }
+  return corner_bytes;
+}
+
+static constexpr std::array<std::array<uint8_t, 6>, 6> EdgeBytes =
+    getEdgeBytes();
+static constexpr std::array<std::array<uint8_t, 6>, 6> CornerBytes =
+    getCornerBytes();
+
+CubieCube::CubieCube(const Cube& cube) : edges(), corners() {
+  for (size_t i = 0; i < EdgeCount; ++i) {
+    const EdgePiece& piece = cube.getEdgeByIndex(i);
+    edges[i] = EdgeBytes[static_cast<uint8_t>(piece.first)]
+                        [static_cast<uint8_t>(piece.second)];
+    assert(edges[i] != UnknownPiece);
+  }
+  for (size_t i = 0; i < CornerCount; ++i) {
+    const CornerPiece& piece = cube.getCornerByIndex(i);
+    corners[i] = CornerBytes[static_cast<uint8_t>(piece.first)]
+                            [static_cast<uint8_t>(piece.second)];
+    assert(corners[i] != UnknownPiece);
+  }
+}
+
+Cube CubieCube::toCube() const {
+  Cube cube{};
+  for (size_t i = 0; i < EdgeCount; ++i) {
+    const EdgePiece& piece = Cube::StartingEdgePieces[getEdgePiece(i)];
+    cube.getEdgeByIndex(i) = isEdgeFlipped(i) ? piece.flip() : piece;
+  }
+  for (size_t i = 0; i < CornerCount; ++i)
+    cube.getCornerByIndex(i) =
+        Cube::StartingCornerPieces[getCornerPiece(i)].rotate(
+            getCornerRotation(i));
+  return cube;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+static bool supportsSsse3() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("ssse3");
+}
+
+static const bool HasSsse3 = supportsSsse3();  // NOLINT(cert-err58-cpp)
+
+[[gnu::target("ssse3")]] static void shuffle(std::array<uint8_t, 16>& edges,
+                                             std::array<uint8_t, 8>& corners,
+                                             const TurnTable& table) {
+  const __m128i edge_lane =
+      _mm_load_si128(reinterpret_cast<const __m128i*>(edges.data()));
+  const __m128i edge_sources = _mm_load_si128(
+      reinterpret_cast<const __m128i*>(table.edge_sources.data()));
+  const __m128i edge_flips = _mm_load_si128(
+      reinterpret_cast<const __m128i*>(table.edge_flips.data()));
+  _mm_store_si128(
+      reinterpret_cast<__m128i*>(edges.data()),
+      _mm_xor_si128(_mm_shuffle_epi8(edge_lane, edge_sources), edge_flips));
+
+  const __m128i corner_lane =
+      _mm_loadl_epi64(reinterpret_cast<const __m128i*>(corners.data()));
+  const __m128i corner_sources = _mm_loadl_epi64(
+      reinterpret_cast<const __m128i*>(table.corner_sources.data()));
+  const __m128i corner_rotations = _mm_loadl_epi64(
+      reinterpret_cast<const __m128i*>(table.corner_rotations.data()));
+  // the rotations are at most 2 + 2 = 4, so they never carry into the piece
+  const __m128i rotated = _mm_add_epi8(
+      _mm_shuffle_epi8(corner_lane, corner_sources), corner_rotations);
+  const __m128i rotation =
+      _mm_and_si128(rotated, _mm_set1_epi8(CubieCube::OrientationMask));
+  const __m128i overflowed = _mm_cmpgt_epi8(rotation, _mm_set1_epi8(2));
+  _mm_storel_epi64(
+      reinterpret_cast<__m128i*>(corners.data()),
+      _mm_sub_epi8(rotated, _mm_and_si128(overflowed, _mm_set1_epi8(3))));
+}
+#endif
+
+void CubieCube::applyVectorized(const Turn& turn) {
+#if defined(__x86_64__) || defined(__i386__)
+  if (HasSsse3) {
+    shuffle(edges, corners, TurnTables[getTurnTableIndex(turn)]);
+    return;
+  }
+#endif
+  applyScalar(turn);
+}
@@ -1,25 +1,11 @@
 #include "Face.h"
-#include "CornerLocation.h"
-#include "Cube.h"
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 
 using enum Face;
 
-Face getLeft(const Face& top, const Face& front) {
-  for (const CornerLocation& corner : Cube::CornerLocationOrder) {
-    if (top == corner.first && front == corner.second) return corner.third;
-    if (top == corner.second && front == corner.third) return corner.first;
-    if (top == corner.third && front == corner.first) return corner.second;
-  }
-  throw std::invalid_argument("Provided top and front faces are inconsistent!");
-}
-
-Face getRight(const Face& top, const Face& front) {
-  return getOpposite(getLeft(top, front));
-}
-
 std::string toStr(const Face& face) {
   switch (face) {
     case U:
@@ -58,7 +44,7 @@ std::string toStrLower(const Face& face) {
   }
 }
 
-std::pair<size_t, Face> parseFace(const std::string& str) {
+std::pair<size_t, Face> parseFace(std::string_view str) {
   if (str.empty()) return {0, {}};
   switch (str[0]) {
     case 'U':
@@ -78,7 +64,7 @@ std::pair<size_t, Face> parseFace(const std::string& str) {
   }
 }
 
-std::pair<size_t, Face> parseWideFace(const std::string& str) {
+std::pair<size_t, Face> parseWideFace(std::string_view str) {
   if (str.empty()) return {0, {}};
   switch (str[0]) {
     case 'u':
@@ -5,6 +5,7 @@
 #include "WideTurn.h"
 #include <cassert>
 #include <string>
+#include <string_view>
 #include <variant>
 
 bool Move::isTurn() const { return std::holds_alternative<Turn>(*this); }
@@ -87,7 +88,7 @@ std::string Move::toStr() const {
   }
 }
 
-std::pair<size_t, Move> Move::parse(const std::string& str) {
+std::pair<size_t, Move> Move::parse(std::string_view str) {
   // try parsing a Turn
   const auto [consumed_for_turn, turn] = Turn::parse(str);
   if (consumed_for_turn != 0) return {consumed_for_turn, Move{turn}};
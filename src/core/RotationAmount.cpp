@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 
 std::string toStr(const RotationAmount& rotationAmount) {
@@ -19,7 +20,7 @@ std::string toStr(const RotationAmount& rotationAmount) {
   }
 }
 
-std::pair<size_t, RotationAmount> parseRotationAmount(const std::string& str) {
+std::pair<size_t, RotationAmount> parseRotationAmount(std::string_view str) {
   size_t consumed = 0;
   size_t rotation_amount = 1;  // default to a single Clockwise RotationAmount
   for (const char& chr : str) {
@@ -2,6 +2,7 @@
 #include <cstddef>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 
 std::string toStr(const RotationAxis& rotationAxis) {
@@ -17,7 +18,7 @@ std::string toStr(const RotationAxis& rotationAxis) {
   }
 }
 
-std::pair<size_t, RotationAxis> parseRotationAxis(const std::string& str) {
+std::pair<size_t, RotationAxis> parseRotationAxis(std::string_view str) {
   if (str.empty()) return {0, {}};
   const char& first_char = str[0];
   if (first_char == 'X' || first_char == 'x')
@@ -2,6 +2,7 @@
 #include <cstddef>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 
 using enum Slice;
@@ -19,7 +20,7 @@ std::string toStr(const Slice& slice) {
   }
 }
 
-std::pair<size_t, Slice> parseSlice(const std::string& str) {
+std::pair<size_t, Slice> parseSlice(std::string_view str) {
   if (str.empty()) return {0, {}};
   switch (str[0]) {
     case 'M':
@@ -3,6 +3,7 @@
 #include "Slice.h"
 #include <cstddef>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <utility>
 
@@ -22,10 +23,10 @@ std::tuple<Turn, Turn, CubeRotation> SliceTurn::expand() const {
                        reverse ? -rotation_amount : rotation_amount}};
 }
 
-std::pair<size_t, SliceTurn> SliceTurn::parse(const std::string& str) {
+std::pair<size_t, SliceTurn> SliceTurn::parse(std::string_view str) {
   const auto [consumed, slice] = parseSlice(str);
   if (consumed == 0) return {0, {}};  // not possible to parse
-  const std::string remaining = str.substr(consumed, str.size() - consumed);
+  const std::string_view remaining = str.substr(consumed);
   const auto [consumed_for_rotation_amount, rotation_amount] =
       parseRotationAmount(remaining);
   return {consumed + consumed_for_rotation_amount,
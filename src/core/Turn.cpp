@@ -3,6 +3,7 @@
 #include "RotationAmount.h"
 #include <cstddef>
 #include <string>
+#include <string_view>
 #include <utility>
 
 std::string Turn::toStr() const {
@@ -12,10 +13,10 @@ std::string Turn::toStr() const {
   return ::toStr(face) + ::toStr(rotation_amount);
 }
 
-std::pair<size_t, Turn> Turn::parse(const std::string& str) {
+std::pair<size_t, Turn> Turn::parse(std::string_view str) {
   const auto [consumed, face] = parseFace(str);
   if (consumed == 0) return {0, {}};  // not possible to parse
-  const std::string remaining = str.substr(consumed, str.size() - consumed);
+  const std::string_view remaining = str.substr(consumed);
   const auto [consumed_for_rotation_amount, rotation_amount] =
       parseRotationAmount(remaining);
   return {consumed + consumed_for_rotation_amount, Turn{face, rotation_amount}};
@@ -3,6 +3,7 @@
 #include "RotationAmount.h"
 #include <cstddef>
 #include <string>
+#include <string_view>
 #include <utility>
 
 std::string WideTurn::toStr() const {
@@ -19,10 +20,10 @@ std::pair<Turn, CubeRotation> WideTurn::expand() const {
                        reverse ? -rotation_amount : rotation_amount}};
 }
 
-std::pair<size_t, WideTurn> WideTurn::parse(const std::string& str) {
+std::pair<size_t, WideTurn> WideTurn::parse(std::string_view str) {
   const auto [consumed, face] = parseWideFace(str);
   if (consumed == 0) return {0, {}};  // not possible to parse
-  const std::string remaining = str.substr(consumed, str.size() - consumed);
+  const std::string_view remaining = str.substr(consumed);
   const auto [consumed_for_rotation_amount, rotation_amount] =
       parseRotationAmount(remaining);
   return {consumed + consumed_for_rotation_amount,
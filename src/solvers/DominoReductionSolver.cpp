@@ -3,13 +3,18 @@
 #include "Combination.h"
 #include "CornerRotationAmount.h"
 #include "Cube.h"
+#include "CubeOrientation.h"
 #include "EdgeOrientationSolver.h"
+#include "LookupTableFile.h"
 #include "MathUtils.h"
+#include "Move.h"
 #include "PackedBitsArray.h"
 #include "RandomUtils.h"
 #include "RotationAmount.h"
 #include "SolverUtils.h"
 #include "StaticVector.h"
+#include "SymmetryUtils.h"
+#include "TrackedCube.h"
 #include "Turn.h"
 #include "TurnSets.h"
 #include "Utils.h"
@@ -18,7 +23,9 @@
 #include <cassert>
 #include <iostream>
 #include <numeric>
+#include <optional>
 #include <stdexcept>
+#include <string>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -35,26 +42,30 @@ static constexpr uint32_t SolvedDescriptor =
          getEdgeIndex(Face::B, Face::L), getEdgeIndex(Face::F, Face::L)})
         .getRank();
 
-static constexpr uint32_t applyTurn(const uint32_t& descriptor,
-                                    const Turn& turn) {
+static constexpr uint32_t applyEdgeCombinationTurn(
+    const uint32_t& edge_combination, const Turn& turn) {
   assert(turn.rotation_amount != RotationAmount::None);
-
-  // parse e_slice_edge_combination and corner_orientations
   Combination<12, 4> e_slice_edge_combination =
-      Combination<12, 4>::parseRank(descriptor / CornerOrientationCount);
+      Combination<12, 4>::parseRank(edge_combination);
+  cycleValues(e_slice_edge_combination, getEdgeCycle(turn.face),
+              static_cast<uint8_t>(turn.rotation_amount));
+  assert(e_slice_edge_combination.isValid());
+  return e_slice_edge_combination.getRank();
+}
+
+static constexpr uint32_t applyCornerOrientationTurn(
+    const uint32_t& corner_orientation, const Turn& turn) {
+  assert(turn.rotation_amount != RotationAmount::None);
+
+  // parse corner_orientations
   std::array<CornerRotationAmount, 8> corner_orientations;
   for (size_t i = 0; i < corner_orientations.size() - 1; ++i)
     corner_orientations[i] = static_cast<CornerRotationAmount>(
-        (descriptor / utility::PowersOf3[i]) % 3);
+        (corner_orientation / utility::PowersOf3[i]) % 3);
   corner_orientations.back() = -std::accumulate(corner_orientations.begin(),
                                                 corner_orientations.end() - 1,
                                                 CornerRotationAmount::None);
 
-  // update e_slice_edge_combination
-  cycleValues(e_slice_edge_combination, getEdgeCycle(turn.face),
-              static_cast<uint8_t>(turn.rotation_amount));
-  assert(e_slice_edge_combination.isValid());
-
   // update corner_orientations
   const std::array<uint8_t, 4> corner_cycle = getCornerCycle(turn.face);
   if (turn.face != Face::U && turn.face != Face::D &&
@@ -68,16 +79,48 @@ static constexpr uint32_t applyTurn(const uint32_t& descriptor,
   }
   cycleTurn(corner_orientations, corner_cycle, turn.rotation_amount);
 
-  // re-encode e_slice_edge_combination and corner_orientations into a
-  // descriptor
-  uint32_t new_descriptor = 0;
+  // re-encode corner_orientations
+  uint32_t new_corner_orientation = 0;
   for (size_t i = 0; i < 7; ++i)
-    new_descriptor +=
+    new_corner_orientation +=
         static_cast<uint8_t>(corner_orientations[i]) * utility::PowersOf3[i];
-  new_descriptor += CornerOrientationCount * e_slice_edge_combination.getRank();
-  return new_descriptor;
+  return new_corner_orientation;
 }
 
+static constexpr uint32_t applyTurn(const uint32_t& descriptor,
+                                    const Turn& turn) {
+  return applyEdgeCombinationTurn(descriptor / CornerOrientationCount, turn) *
+             CornerOrientationCount +
+         applyCornerOrientationTurn(descriptor % CornerOrientationCount, turn);
+}
+
+using DominoReductionMoveTable =
+    ProductMoveTable<EdgeCombinationCount, CornerOrientationCount,
+                     EdgeOrientationPreservingTurns, applyEdgeCombinationTurn,
+                     applyCornerOrientationTurn>;
+
+/**
+ * Equivalent to applyTurn, but looks the result up in a
+ * DominoReductionMoveTable instead of decoding the descriptor, which makes
+ * generating the lookup tables much faster.
+ */
+static uint32_t applyTurnWithMoveTable(const uint32_t& descriptor,
+                                       const Turn& turn) {
+  static const DominoReductionMoveTable move_table{};
+  return move_table.apply(descriptor, turn);
+}
+
+/**
+ * Rotations that keep both the UD and FB axes in place preserve
+ * EdgeOrientationPreservingTurns and the E slice, so conjugate descriptors are
+ * the same distance from solved.
+ */
+static constexpr auto Symmetries = getAxisSymmetries<Face::U, Face::F>();
+using Reduction =
+    SymmetryReduction<DescriptorCount, CornerOrientationCount,
+                      EdgeOrientationPreservingTurns, applyTurn,
+                      SolvedDescriptor, Symmetries>;
+
 static uint32_t getDescriptor(const Cube& cube) {
   uint32_t descriptor = 0;
   for (size_t i = 0; i < Cube::CornerLocationOrder.size() - 1; ++i) {
@@ -109,37 +152,106 @@ static uint32_t getDescriptor(const Cube& cube) {
   return descriptor;
 }
 
+uint32_t getDominoReductionDescriptor(const Cube& cube) {
+  return getDescriptor(cube);
+}
+
+uint32_t applyDominoReductionTurn(const uint32_t& descriptor,
+                                  const Turn& turn) {
+  // unlike DominoReductionMoveTable, this needs a row for every Turn
+  static const ProductMoveTable<EdgeCombinationCount, CornerOrientationCount,
+                                AllPossibleTurns, applyEdgeCombinationTurn,
+                                applyCornerOrientationTurn>
+      move_table{};
+  return move_table.apply(descriptor, turn);
+}
+
 bool isDominoReduced(const Cube& cube) {
   return areEdgesOriented(cube) && getDescriptor(cube) == SolvedDescriptor;
 }
 
-Algorithm solveDominoReduction(Cube cube) {
-  static constexpr uint8_t DescriptorBits =
-      utility::requiredBits(DescriptorCount);
-  static constexpr uint8_t TurnBits =
-      utility::requiredBits(EdgeOrientationPreservingTurns.size());
-  static constexpr uint8_t CompressedBits = DescriptorBits + TurnBits;
-  static constexpr auto LookupTable =
+bool isDominoReduced(const TrackedCube& cube) {
+  return areEdgesOriented(cube) &&
+         cube.getDominoReductionDescriptor() == SolvedDescriptor;
+}
+
+static constexpr char LookupTableFileName[] =
+    "./lookup_tables/DominoReductionLookupTable.bin";
+static constexpr char PruningTableFileName[] =
+    "./lookup_tables/DominoReductionSymmetricPruningTable.bin";
+
+static Algorithm solveDescriptor(const uint32_t& descriptor) {
+  static constexpr uint8_t CompressedBits =
+      getCompressedBits<DescriptorCount, EdgeOrientationPreservingTurns>();
+  // mapped on first use, preferring the smallest available table. An invalid
+  // file is skipped like a missing one, falling through to the next table
+  static const std::optional<utility::MappedLookupTable> MappedPruningTable =
+      []() -> std::optional<utility::MappedLookupTable> {
+    try {
+      return Reduction::mapPruningTable(PruningTableFileName);
+    } catch (const std::runtime_error&) {
+      return std::nullopt;
+    }
+  }();
+  static const std::optional<utility::MappedLookupTable> MappedLookupTable =
+      []() -> std::optional<utility::MappedLookupTable> {
+    if (MappedPruningTable) return std::nullopt;
+    try {
+      return mapLookupTable<DescriptorCount, EdgeOrientationPreservingTurns,
+                            applyTurnWithMoveTable, SolvedDescriptor>(
+          LookupTableFileName);
+    } catch (const std::runtime_error&) {
+      return std::nullopt;
+    }
+  }();
+
+  if (MappedPruningTable) {
+    static const Reduction reduction{};
+    return reduction.solve(
+        utility::PackedBitsArrayView<2, Reduction::ReducedCount>{
+            MappedPruningTable->data()},
+        descriptor);
+  }
+  if (MappedLookupTable)
+    return solveWithLookupTable<DescriptorCount,
+                                EdgeOrientationPreservingTurns,
+                                SolvedDescriptor>(
+        utility::PackedBitsArrayView<CompressedBits, DescriptorCount>{
+            MappedLookupTable->data()},
+        descriptor);
+
+#ifdef RUBIKS_CUBE_EMBED_LOOKUP_TABLES
+  static constexpr auto EmbeddedLookupTable =
       utility::PackedBitsArray<CompressedBits, DescriptorCount>::fromRawData({
 // TODO: replace with #embed in c++23
 #include "DominoReductionLookupTable.h"
       });
-  // TODO: remove code duplication between this and getSolver in SolverUtils.h
-  static constexpr auto solver = [](uint32_t descriptor) {
-    Algorithm alg;
-    while (descriptor != SolvedDescriptor) {
-      const auto compressed_optimal_move = LookupTable[descriptor];
-      alg.push_back(
-          Move{EdgeOrientationPreservingTurns[compressed_optimal_move >>
-                                              DescriptorBits]});
-      descriptor = compressed_optimal_move % (1 << DescriptorBits);
-    }
-    return alg;
-  };
+  return solveWithLookupTable<DescriptorCount, EdgeOrientationPreservingTurns,
+                              SolvedDescriptor>(EmbeddedLookupTable,
+                                                descriptor);
+#else
+  // generated on first use like the half turn reduction table, and cached in
+  // LookupTableFileName for the next process
+  static const auto runtime_solver =
+      getRuntimeSolver<DescriptorCount, EdgeOrientationPreservingTurns,
+                       applyTurnWithMoveTable, SolvedDescriptor>(
+          LookupTableFileName);
+  return runtime_solver(descriptor);
+#endif
+}
 
+Algorithm solveDominoReduction(Cube cube) {
   const Algorithm edge_orientation_solve = solveEdgeOrientation(cube);
   cube.apply(edge_orientation_solve);
-  return edge_orientation_solve + solver(getDescriptor(cube));
+  return edge_orientation_solve + solveDescriptor(getDescriptor(cube));
+}
+
+Algorithm solveDominoReduction(const TrackedCube& cube) {
+  const Algorithm edge_orientation_solve = solveEdgeOrientation(cube);
+  uint32_t descriptor = cube.getDominoReductionDescriptor();
+  for (const Move& move : edge_orientation_solve)
+    descriptor = applyDominoReductionTurn(descriptor, move.getTurn());
+  return edge_orientation_solve + solveDescriptor(descriptor);
 }
 
 // Test functions
@@ -174,6 +286,17 @@ static void testApplyTurn() {
   }
 }
 
+static void testMoveTable() {
+  static constexpr size_t Count = 1000;
+  for (size_t i = 0; i < Count; ++i) {
+    const uint32_t descriptor = utility::randomInt<DescriptorCount>();
+    for (const Turn& turn : EdgeOrientationPreservingTurns)
+      if (applyTurnWithMoveTable(descriptor, turn) !=
+          applyTurn(descriptor, turn))
+        throw std::logic_error("Move table differs from applyTurn!");
+  }
+}
+
 static void testStatistics() {
   std::unordered_set<uint32_t> seen_descriptors{};
   seen_descriptors.insert(SolvedDescriptor);
@@ -187,7 +310,7 @@ static void testStatistics() {
     sizes.push_back(current.size());
     for (const uint32_t& idx : current) {
       for (const Turn& turn : EdgeOrientationPreservingTurns) {
-        const uint32_t next_idx = applyTurn(idx, turn);
+        const uint32_t next_idx = applyTurnWithMoveTable(idx, turn);
         if (seen_descriptors.insert(next_idx).second) next.push_back(next_idx);
       }
     }
@@ -200,15 +323,138 @@ static void testStatistics() {
     throw std::logic_error("Some descriptors required more than 10 moves!");
 }
 
+static void testParallelOptimalMoves() {
+  const auto serial_optimal_moves =
+      detail::getCompressedOptimalMoves<
+          DescriptorCount, EdgeOrientationPreservingTurns,
+          applyTurnWithMoveTable, SolvedDescriptor, true>();
+  for (const size_t thread_count : {size_t{1}, size_t{2}, size_t{5}}) {
+    const auto parallel_optimal_moves =
+        detail::getCompressedOptimalMovesParallel<
+            DescriptorCount, EdgeOrientationPreservingTurns,
+            applyTurnWithMoveTable, SolvedDescriptor>(thread_count);
+    if (!std::equal(serial_optimal_moves.rawData().begin(),
+                    serial_optimal_moves.rawData().end(),
+                    parallel_optimal_moves.rawData().begin()))
+      throw std::logic_error("Parallel optimal moves differ from serial!");
+  }
+}
+
+static void testLookupTableFile() {
+  const auto optimal_moves =
+      detail::getCompressedOptimalMoves<
+          DescriptorCount, EdgeOrientationPreservingTurns,
+          applyTurnWithMoveTable, SolvedDescriptor, true>();
+  const std::optional<utility::MappedLookupTable> mapped_lookup_table =
+      mapLookupTable<DescriptorCount, EdgeOrientationPreservingTurns,
+                     applyTurnWithMoveTable, SolvedDescriptor>(
+          LookupTableFileName);
+  if (!mapped_lookup_table)
+    throw std::logic_error("Lookup table file was not generated!");
+  if (!std::equal(optimal_moves.rawData().begin(),
+                  optimal_moves.rawData().end(), mapped_lookup_table->data()))
+    throw std::logic_error("Lookup table file differs from optimal moves!");
+
+  static constexpr size_t Count = 1000;
+  const utility::PackedBitsArrayView<
+      getCompressedBits<DescriptorCount, EdgeOrientationPreservingTurns>(),
+      DescriptorCount>
+      view{mapped_lookup_table->data()};
+  for (size_t i = 0; i < Count; ++i) {
+    const uint32_t descriptor = utility::randomInt<DescriptorCount>();
+    if (solveWithLookupTable<DescriptorCount, EdgeOrientationPreservingTurns,
+                             SolvedDescriptor>(view, descriptor) !=
+        solveWithLookupTable<DescriptorCount, EdgeOrientationPreservingTurns,
+                             SolvedDescriptor>(optimal_moves, descriptor))
+      throw std::logic_error("Mapped lookup table gave a different solve!");
+  }
+}
+
+static void testSymmetryReduction() {
+  static_assert(Symmetries.size() == 4);
+  static_assert(Reduction::ReducedCount < DescriptorCount / 3);
+  const Reduction reduction{};
+
+  // every conjugate of a descriptor should have the same reduction, whose
+  // representative is one of those conjugates. The conjugates are found by
+  // conjugating every turn of an algorithm by each symmetry
+  static constexpr size_t Count = 1000;
+  for (size_t i = 0; i < Count; ++i) {
+    const Algorithm alg = Algorithm::random(20, EdgeOrientationPreservingTurns);
+    uint32_t descriptor = SolvedDescriptor;
+    std::array<uint32_t, Symmetries.size()> conjugate_descriptors;
+    conjugate_descriptors.fill(SolvedDescriptor);
+    for (const Move& move : alg) {
+      descriptor = applyTurn(descriptor, move.getTurn());
+      for (size_t s = 0; s < Symmetries.size(); ++s)
+        conjugate_descriptors[s] =
+            applyTurn(conjugate_descriptors[s],
+                      Symmetries[s].apply(move.getTurn()));
+    }
+    const size_t reduced = reduction.reduce(descriptor);
+    for (const uint32_t& conjugate_descriptor : conjugate_descriptors)
+      if (reduction.reduce(conjugate_descriptor) != reduced)
+        throw std::logic_error("Conjugate descriptors reduce differently!");
+    if (std::find(conjugate_descriptors.begin(), conjugate_descriptors.end(),
+                  reduction.getRepresentative(reduced)) ==
+        conjugate_descriptors.end())
+      throw std::logic_error("Representative is not a conjugate!");
+  }
+}
+
+static void testPruningTable() {
+  const auto optimal_moves =
+      detail::getCompressedOptimalMoves<
+          DescriptorCount, EdgeOrientationPreservingTurns,
+          applyTurnWithMoveTable, SolvedDescriptor, true>();
+  const std::optional<utility::MappedLookupTable> mapped_pruning_table =
+      Reduction::mapPruningTable(PruningTableFileName);
+  if (!mapped_pruning_table)
+    throw std::logic_error("Pruning table file was not generated!");
+  if (mapped_pruning_table->size() != (Reduction::ReducedCount * 2 + 7) / 8)
+    throw std::logic_error("Pruning table is not 2 bits per descriptor!");
+  const utility::PackedBitsArrayView<2, Reduction::ReducedCount>
+      pruning_table{mapped_pruning_table->data()};
+  const Reduction reduction{};
+
+  static constexpr size_t Count = 1000;
+  for (size_t i = 0; i < Count; ++i) {
+    const uint32_t descriptor = utility::randomInt<DescriptorCount>();
+    const Algorithm solve = reduction.solve(pruning_table, descriptor);
+    uint32_t solved_descriptor = descriptor;
+    for (const Move& move : solve)
+      solved_descriptor =
+          applyTurnWithMoveTable(solved_descriptor, move.getTurn());
+    if (solved_descriptor != SolvedDescriptor)
+      throw std::logic_error("Pruning table solve did not solve!");
+    if (solve.size() !=
+        solveWithLookupTable<DescriptorCount, EdgeOrientationPreservingTurns,
+                             SolvedDescriptor>(optimal_moves, descriptor)
+            .size())
+      throw std::logic_error("Pruning table solve is not optimal!");
+  }
+}
+
 void runDominoReductionSolverTests() {
   std::cout << "Generating lookup table for Domino reduction...\n";
   generateLookupTable<DescriptorCount, EdgeOrientationPreservingTurns,
-                      applyTurn, SolvedDescriptor>(
+                      applyTurnWithMoveTable, SolvedDescriptor>(
       "./include/solvers/DominoReductionLookupTable.h");
+  generateLookupTableFile<DescriptorCount, EdgeOrientationPreservingTurns,
+                          applyTurnWithMoveTable, SolvedDescriptor>(
+      LookupTableFileName);
+  std::cout << "Generating pruning table for Domino reduction...\n";
+  Reduction{}.generatePruningTableFile(PruningTableFileName);
 
   testGetDescriptor();
   testApplyTurn();
+  testMoveTable();
   std::cout << "Testing Domino reduction statistics...\n";
   testStatistics();
+  std::cout << "Testing parallel Domino reduction lookup table...\n";
+  testParallelOptimalMoves();
+  testLookupTableFile();
+  testSymmetryReduction();
+  testPruningTable();
 }
 }  // namespace solvers
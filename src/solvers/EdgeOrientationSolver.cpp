@@ -4,8 +4,11 @@
 #include "Move.h"
 #include "SolverUtils.h"
 #include "StaticVector.h"
+#include "SymmetryUtils.h"
+#include "TrackedCube.h"
 #include "Turn.h"
 #include "TurnSets.h"
+#include <algorithm>
 #include <array>
 #include <bit>
 #include <cstdint>
@@ -95,14 +98,35 @@ static uint16_t getEdgeOrientation(const Cube& cube) {
   return edge_orientation;
 }
 
+uint16_t getEdgeOrientationDescriptor(const Cube& cube) {
+  return getEdgeOrientation(cube);
+}
+
+uint16_t applyEdgeOrientationTurn(const uint16_t& descriptor,
+                                  const Turn& turn) {
+  return applyTurn(descriptor, turn);
+}
+
 bool areEdgesOriented(const Cube& cube) {
   return getEdgeOrientation(cube) == SolvedDescriptor;
 }
 
-Algorithm solveEdgeOrientation(const Cube& cube) {
+bool areEdgesOriented(const TrackedCube& cube) {
+  return cube.getEdgeOrientationDescriptor() == SolvedDescriptor;
+}
+
+static Algorithm solveDescriptor(const uint16_t& descriptor) {
   static constexpr auto solver = getSolver<DescriptorCount, AllPossibleTurns,
                                            applyTurn, SolvedDescriptor>();
-  return solver(getEdgeOrientation(cube));
+  return solver(descriptor);
+}
+
+Algorithm solveEdgeOrientation(const Cube& cube) {
+  return solveDescriptor(getEdgeOrientation(cube));
+}
+
+Algorithm solveEdgeOrientation(const TrackedCube& cube) {
+  return solveDescriptor(cube.getEdgeOrientationDescriptor());
 }
 
 // Test functions
@@ -136,8 +160,73 @@ static void testApplyTurn() {
   }
 }
 
+static void testParallelOptimalMoves() {
+  const auto serial_optimal_moves =
+      detail::getCompressedOptimalMoves<DescriptorCount, AllPossibleTurns,
+                                        applyTurn, SolvedDescriptor, true>();
+  for (const size_t thread_count : {size_t{1}, size_t{2}, size_t{5}}) {
+    const auto parallel_optimal_moves =
+        detail::getCompressedOptimalMovesParallel<
+            DescriptorCount, AllPossibleTurns, applyTurn, SolvedDescriptor>(
+            thread_count);
+    if (!std::equal(serial_optimal_moves.rawData().begin(),
+                    serial_optimal_moves.rawData().end(),
+                    parallel_optimal_moves.rawData().begin()))
+      throw std::logic_error("Parallel optimal moves differ from serial!");
+  }
+}
+
+static void testPruningTable() {
+  static constexpr auto PruningTable =
+      detail::getPruningTable<DescriptorCount, AllPossibleTurns, applyTurn,
+                              SolvedDescriptor, false>();
+  static_assert(sizeof(PruningTable) == DescriptorCount / 4);
+  static constexpr auto solver = getSolver<DescriptorCount, AllPossibleTurns,
+                                           applyTurn, SolvedDescriptor>();
+
+  for (uint16_t descriptor = 0; descriptor < DescriptorCount; ++descriptor) {
+    const Algorithm solve =
+        solveWithPruningTable<DescriptorCount, AllPossibleTurns, applyTurn,
+                              SolvedDescriptor>(PruningTable, descriptor);
+    uint16_t edge_orientation = descriptor;
+    for (const Move& move : solve)
+      edge_orientation = applyTurn(edge_orientation, move.getTurn());
+    if (edge_orientation != SolvedDescriptor)
+      throw std::logic_error("Pruning table solve did not solve!");
+    if (solve.size() != solver(descriptor).size())
+      throw std::logic_error("Pruning table solve is not optimal!");
+  }
+}
+
+static void testSymmetricSolver() {
+  static constexpr auto Symmetries = getAxisSymmetries<Face::F>();
+  static_assert(Symmetries.size() == 8);
+  using Reduction = SymmetryReduction<DescriptorCount, 1, AllPossibleTurns,
+                                      applyTurn, SolvedDescriptor, Symmetries>;
+  static_assert(Reduction::ReducedCount < DescriptorCount / 4);
+
+  static constexpr auto solver = getSolver<DescriptorCount, AllPossibleTurns,
+                                           applyTurn, SolvedDescriptor>();
+  static constexpr auto symmetric_solver =
+      getSymmetricSolver<DescriptorCount, 1, AllPossibleTurns, applyTurn,
+                         SolvedDescriptor, Symmetries>();
+  for (uint16_t descriptor = 0; descriptor < DescriptorCount; ++descriptor) {
+    const Algorithm solve = symmetric_solver(descriptor);
+    uint16_t edge_orientation = descriptor;
+    for (const Move& move : solve)
+      edge_orientation = applyTurn(edge_orientation, move.getTurn());
+    if (edge_orientation != SolvedDescriptor)
+      throw std::logic_error("Symmetric solve did not solve!");
+    if (solve.size() != solver(descriptor).size())
+      throw std::logic_error("Symmetric solve is not optimal!");
+  }
+}
+
 void runEdgeOrientationSolverTests() {
   testGetEdgeOrientation();
   testApplyTurn();
+  testParallelOptimalMoves();
+  testPruningTable();
+  testSymmetricSolver();
 }
 }  // namespace solvers
@@ -6,6 +6,7 @@
 #include "MathUtils.h"
 #include "Permutation.h"
 #include "SolverUtils.h"
+#include "TrackedCube.h"
 #include "Turn.h"
 #include "TurnSets.h"
 #include <algorithm>
@@ -13,22 +14,100 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace solvers {
 static constexpr uint16_t CornerCombinationCount = utility::nChooseK(8, 4);
 static constexpr uint16_t EdgeCombinationCount = utility::nChooseK(8, 4);
 static constexpr uint16_t PiecesCombinationCount =
     EdgeCombinationCount * CornerCombinationCount;
-static constexpr uint16_t ParityCount = 2;
-static constexpr uint16_t ParityAndPiecesCombinationCount =
-    ParityCount * PiecesCombinationCount;
-static constexpr uint16_t CornerThreeParityCount = 3;
+static constexpr uint16_t CornerCosetCount = utility::factorial(3);
 static constexpr uint16_t DescriptorCount =
-    CornerThreeParityCount * ParityAndPiecesCombinationCount;
+    CornerCosetCount * PiecesCombinationCount;
 static constexpr uint16_t SolvedDescriptor =
     Combination<8, 4>({0, 2, 4, 6}).getRank();
 
-static constexpr uint16_t getCornerThreeParity(
+/**
+ * @return The image of the given tetrad permutation in S4 / V4 = S3, i.e. how
+ * it permutes the 3 ways of splitting the tetrad into 2 pairs, where split k
+ * pairs 0 with k + 1.
+ */
+static constexpr Permutation<3> getSplitPermutation(
+    const Permutation<4>& permutation) {
+  Permutation<3> split_permutation;
+  for (uint8_t k = 0; k < 3; ++k) {
+    const uint8_t first = permutation[0];
+    const uint8_t second = permutation[k + 1];
+    // the split containing {first, second} pairs 0 with whichever of them is
+    // not 0, or if neither is, with the remaining value of {1, 2, 3}
+    const uint8_t zero_partner = first == 0    ? second
+                                 : second == 0 ? first
+                                               : 6 - first - second;
+    split_permutation[k] = zero_partner - 1;
+  }
+  return split_permutation;
+}
+
+/**
+ * The half turns permute each tetrad of corners with a swap of diagonally
+ * opposite corners. In the group they generate, each permutation of the even
+ * tetrad is paired with permutations of the odd tetrad that all have the same
+ * split permutation, which is stored here by the rank of the even tetrad
+ * permutation.
+ */
+static constexpr std::array<Permutation<3>, 24> HalfTurnSplitPermutations =
+    []() {
+      std::array<Permutation<3>, 24> split_permutations{};
+      std::array<bool, 24> found{};
+      std::vector<std::pair<Permutation<4>, Permutation<4>>> frontier{
+          {Permutation<4>::identity(), Permutation<4>::identity()}};
+      found[0] = true;
+      split_permutations[0] = Permutation<3>::identity();
+      while (!frontier.empty()) {
+        const auto [even_permutation, odd_permutation] = frontier.back();
+        frontier.pop_back();
+        for (const Turn& turn : HalfTurnReductionPreservingTurns) {
+          const std::array<uint8_t, 4> cycle = getCornerCycle(turn.face);
+          // diagonally opposite corners are in the same tetrad
+          auto next_even_permutation = even_permutation;
+          auto next_odd_permutation = odd_permutation;
+          auto& even_swapped = cycle[0] % 2 == 0 ? next_even_permutation
+                                                 : next_odd_permutation;
+          auto& odd_swapped = cycle[0] % 2 == 0 ? next_odd_permutation
+                                                : next_even_permutation;
+          std::swap(even_swapped[cycle[0] / 2], even_swapped[cycle[2] / 2]);
+          std::swap(odd_swapped[cycle[1] / 2], odd_swapped[cycle[3] / 2]);
+
+          const size_t rank = next_even_permutation.getRank();
+          if (found[rank]) {
+            if (split_permutations[rank] !=
+                getSplitPermutation(next_odd_permutation))
+              throw std::logic_error("Split permutation is not unique!");
+            continue;
+          }
+          found[rank] = true;
+          split_permutations[rank] = getSplitPermutation(next_odd_permutation);
+          frontier.emplace_back(next_even_permutation, next_odd_permutation);
+        }
+      }
+      return split_permutations;
+    }();
+
+/**
+ * @return Which of the CornerCosetCount cosets of the corner permutations
+ * reachable by half turns the given corner permutation is in. Relabelling the
+ * pieces with the permutation of a half turn reduced Cube changes the split
+ * permutation of the even tetrad by the corresponding element of
+ * HalfTurnSplitPermutations and that of the odd tetrad by the same amount, so
+ * the split permutation of the odd tetrad relative to the even tetrad does not
+ * change.
+ */
+static constexpr uint16_t getCornerCoset(
     const Permutation<8>& corner_permutation) {
   // extract relative permutation of each tetrad
   Permutation<4> even_tetrad_permutation;
@@ -46,16 +125,18 @@ static constexpr uint16_t getCornerThreeParity(
   assert(even_tetrad_permutation.isValid());
   assert(odd_tetrad_permutation.isValid());
 
-  if (corner_permutation.isOdd()) even_tetrad_permutation.flipParity();
-
-  /** static **/ constexpr std::array<uint8_t, 24> TetradThreeParity{
-      0, 2, 1, 1, 2, 0, 2, 0, 2, 0, 1, 1, 1, 1, 0, 2, 0, 2, 0, 2, 1, 1, 2, 0};
-  static_assert(std::equal(TetradThreeParity.begin(), TetradThreeParity.end(),
-                           TetradThreeParity.rbegin(),
-                           TetradThreeParity.rend()));
-  return (TetradThreeParity[even_tetrad_permutation.getRank()] -
-          TetradThreeParity[odd_tetrad_permutation.getRank()] + 3) %
-         3;
+  const Permutation<3>& even_split_permutation =
+      HalfTurnSplitPermutations[even_tetrad_permutation.getRank()];
+  const Permutation<3> odd_split_permutation =
+      getSplitPermutation(odd_tetrad_permutation);
+  // odd_split_permutation followed by the inverse of even_split_permutation
+  Permutation<3> inverse_even_split_permutation;
+  for (uint8_t k = 0; k < 3; ++k)
+    inverse_even_split_permutation[even_split_permutation[k]] = k;
+  Permutation<3> coset;
+  for (uint8_t k = 0; k < 3; ++k)
+    coset[k] = inverse_even_split_permutation[odd_split_permutation[k]];
+  return coset.getRank();
 }
 
 static constexpr uint16_t applyTurn(const uint16_t& descriptor,
@@ -66,28 +147,24 @@ static constexpr uint16_t applyTurn(const uint16_t& descriptor,
       Combination<8, 4>::parseRank(descriptor % CornerCombinationCount);
   Combination<8, 4> m_slice_edge_combination = Combination<8, 4>::parseRank(
       (descriptor / CornerCombinationCount) % EdgeCombinationCount);
-  bool odd_parity =
-      (descriptor % ParityAndPiecesCombinationCount) / PiecesCombinationCount;
   Permutation<8> corner_permutation = [&]() {
-    const uint16_t corner_three_parity =
-        descriptor / ParityAndPiecesCombinationCount;
-    // pick any even and odd tetrad permutations that are consistent
-    // with corner_three_parity
-    auto even_tetrad_permutation =
-        Permutation<4>::parseRank(2 * corner_three_parity);
-    auto odd_tetrad_permutation = Permutation<4>::parseRank(0);
+    // any odd tetrad permutation in the coset will do, with the even tetrad
+    // solved since its split permutation is then the identity
+    const uint16_t coset = descriptor / PiecesCombinationCount;
+    auto odd_tetrad_permutation = Permutation<4>::identity();
+    while (getSplitPermutation(odd_tetrad_permutation).getRank() != coset)
+      odd_tetrad_permutation.nextPermutation();
     Permutation<8> corner_perm;
     uint8_t i = 0;
     for (size_t j = 0; j < corner_perm.size(); ++j) {
-      if (i < even_tetrad_permutation.size() &&
-          even_tetrad_corner_combination[i] == j)
-        corner_perm[j] = 2 * even_tetrad_permutation[i++];
+      if (i < 4 && even_tetrad_corner_combination[i] == j)
+        corner_perm[j] = 2 * i++;
       else {
         assert(j >= i);
         corner_perm[j] = 2 * odd_tetrad_permutation[j - i] + 1;
       }
     }
-    assert(i == even_tetrad_permutation.size());
+    assert(i == 4);
     assert(corner_perm.isValid());
     return corner_perm;
   }();
@@ -102,19 +179,13 @@ static constexpr uint16_t applyTurn(const uint16_t& descriptor,
               static_cast<uint8_t>(turn.rotation_amount));
   assert(m_slice_edge_combination.isValid());
 
-  // half turns flip the edge and corner parity
-  odd_parity ^= turn.rotation_amount != RotationAmount::HalfTurn;
-
   cycleTurn(corner_permutation, getCornerCycle(turn.face),
             turn.rotation_amount);
   assert(corner_permutation.isValid());
-  const uint16_t new_corner_three_parity =
-      getCornerThreeParity(corner_permutation);
 
   return even_tetrad_corner_combination.getRank() +
          m_slice_edge_combination.getRank() * CornerCombinationCount +
-         (odd_parity ? PiecesCombinationCount : 0) +
-         new_corner_three_parity * ParityAndPiecesCombinationCount;
+         getCornerCoset(corner_permutation) * PiecesCombinationCount;
 }
 
 /**
@@ -177,7 +248,6 @@ static uint16_t getDescriptor(const Cube& cube) {
     assert(corner_permutation[j] != Cube::StartingCornerPieces.size());
   }
   assert(corner_permutation.isValid());
-  const uint16_t corner_three_parity = getCornerThreeParity(corner_permutation);
 
   // sanity check
   assert(std::all_of(
@@ -187,41 +257,56 @@ static uint16_t getDescriptor(const Cube& cube) {
 
   return even_tetrad_corner_combination.getRank() +
          m_slice_edge_combination.getRank() * CornerCombinationCount +
-         (corner_permutation.isOdd() ? PiecesCombinationCount : 0) +
-         corner_three_parity * ParityAndPiecesCombinationCount;
+         getCornerCoset(corner_permutation) * PiecesCombinationCount;
+}
+
+uint16_t getHalfTurnReductionDescriptor(const Cube& cube) {
+  return getDescriptor(cube);
+}
+
+uint16_t applyHalfTurnReductionTurn(const uint16_t& descriptor,
+                                    const Turn& turn) {
+  static const MoveTable<DescriptorCount, DominoReductionPreservingTurns,
+                         applyTurn>
+      move_table{};
+  return move_table.apply(descriptor, turn);
 }
 
 bool isHalfTurnReduced(const Cube& cube) {
   return isDominoReduced(cube) && getDescriptor(cube) == SolvedDescriptor;
 }
 
-Algorithm solveHalfTurnReduction(Cube cube) {
-  static constexpr uint8_t DescriptorBits =
-      utility::requiredBits(DescriptorCount);
-  static constexpr uint8_t TurnBits =
-      utility::requiredBits(DominoReductionPreservingTurns.size());
-  static constexpr uint8_t CompressedBits = DescriptorBits + TurnBits;
-  static constexpr auto LookupTable =
-      utility::PackedBitsArray<CompressedBits, DescriptorCount>::fromRawData({
-// TODO: replace with #embed in c++23
-#include "HalfTurnReductionLookupTable.h"
-      });
-  // TODO: remove code duplication between this and getSolver in SolverUtils.h
-  static constexpr auto solver = [](uint16_t descriptor) {
-    Algorithm alg;
-    while (descriptor != SolvedDescriptor) {
-      const auto compressed_optimal_move = LookupTable[descriptor];
-      alg.push_back(
-          Move{DominoReductionPreservingTurns[compressed_optimal_move >>
-                                              DescriptorBits]});
-      descriptor = compressed_optimal_move % (1 << DescriptorBits);
-    }
-    return alg;
-  };
+bool isHalfTurnReduced(const TrackedCube& cube) {
+  return isDominoReduced(cube) &&
+         cube.getHalfTurnReductionDescriptor() == SolvedDescriptor;
+}
 
+static constexpr char LookupTableFileName[] =
+    "./lookup_tables/HalfTurnReductionLookupTable.bin";
+
+static Algorithm solveDescriptor(const uint16_t& descriptor) {
+  // too large to evaluate at compile time, so built on first use instead
+  static const auto solver =
+      getRuntimeSolver<DescriptorCount, DominoReductionPreservingTurns,
+                       applyTurn, SolvedDescriptor>(LookupTableFileName);
+  return solver(descriptor);
+}
+
+Algorithm solveHalfTurnReduction(Cube cube) {
   const Algorithm domino_reduction_solve = solveDominoReduction(cube);
   cube.apply(domino_reduction_solve);
-  return domino_reduction_solve + solver(getDescriptor(cube));
+  return domino_reduction_solve + solveDescriptor(getDescriptor(cube));
+}
+
+Algorithm solveHalfTurnReduction(const TrackedCube& cube) {
+  const Algorithm domino_reduction_solve = solveDominoReduction(cube);
+  if (domino_reduction_solve.empty())
+    return solveDescriptor(cube.getHalfTurnReductionDescriptor());
+  // the descriptor is only tracked once the Cube is domino reduced
+  TrackedCube domino_reduced_cube = cube;
+  domino_reduced_cube.apply(domino_reduction_solve);
+  return domino_reduction_solve +
+         solveDescriptor(domino_reduced_cube.getHalfTurnReductionDescriptor());
 }
 
 // Test functions
@@ -256,12 +341,46 @@ static void testApplyTurn() {
   }
 }
 
-void runHalfTurnReductionSolverTests() {
-  generateLookupTable<DescriptorCount, DominoReductionPreservingTurns,
-                      applyTurn, SolvedDescriptor>(
-      "./include/solvers/HalfTurnReductionLookupTable.h");
+static void testRuntimeLookupTable() {
+  using LookupTable = RuntimeLookupTable<DescriptorCount,
+                                         DominoReductionPreservingTurns,
+                                         applyTurn, SolvedDescriptor>;
+  static constexpr char FileName[] =
+      "./lookup_tables/TestHalfTurnReductionLookupTable.bin";
+  const auto optimal_moves = detail::getCompressedOptimalMoves<
+      DescriptorCount, DominoReductionPreservingTurns, applyTurn,
+      SolvedDescriptor, true>();
+  const auto matches_optimal_moves = [&](const LookupTable& lookup_table) {
+    return std::equal(optimal_moves.rawData().begin(),
+                      optimal_moves.rawData().end(), lookup_table.data());
+  };
+
+  std::filesystem::remove(FileName);
+  const LookupTable generated{FileName};
+  if (!generated.wasGenerated() || !matches_optimal_moves(generated))
+    throw std::logic_error("Runtime lookup table was not generated!");
+  const LookupTable cached{FileName};
+  if (cached.wasGenerated() || !matches_optimal_moves(cached))
+    throw std::logic_error("Runtime lookup table was not cached!");
 
+  // a corrupted cache should be regenerated rather than used
+  {
+    std::fstream file{FileName, std::ios::in | std::ios::out |
+                                    std::ios::binary};
+    file.seekg(-1, std::ios::end);
+    const auto last_byte = static_cast<char>(file.get() ^ 0xFF);
+    file.seekp(-1, std::ios::end);
+    file.put(last_byte);
+  }
+  const LookupTable regenerated{FileName};
+  if (!regenerated.wasGenerated() || !matches_optimal_moves(regenerated))
+    throw std::logic_error("Corrupted lookup table was not regenerated!");
+  std::filesystem::remove(FileName);
+}
+
+void runHalfTurnReductionSolverTests() {
   testGetDescriptor();
   testApplyTurn();
+  testRuntimeLookupTable();
 }
 }  // namespace solvers
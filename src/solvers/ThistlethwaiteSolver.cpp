@@ -1,132 +1,238 @@
 #include "ThistlethwaiteSolver.h"
 #include "Algorithm.h"
 #include "Cube.h"
-#include "Face.h"
+#include "DominoReductionSolver.h"
+#include "EdgeOrientationSolver.h"
 #include "HalfTurnReductionSolver.h"
 #include "MathUtils.h"
 #include "Permutation.h"
 #include "RotationAmount.h"
 #include "SolverUtils.h"
+#include "TrackedCube.h"
+#include "Turn.h"
 #include "TurnSets.h"
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <stdexcept>
+#include <vector>
 
 namespace solvers {
 static constexpr uint32_t MSlicePermutationCount = utility::factorial(4);
 static constexpr uint32_t SSlicePermutationCount = utility::factorial(4);
 static constexpr uint32_t MSSlicePermutationCounts =
     MSlicePermutationCount * SSlicePermutationCount;
+// the half turns are even permutations of the edges, so the parity of the E
+// slice permutation is determined by the M and S slice permutations
 static constexpr uint32_t ESlicePermutationCount = utility::factorial(4) / 2;
 static constexpr uint32_t EdgePermutationCount =
     MSSlicePermutationCounts * ESlicePermutationCount;
-static constexpr uint32_t PrimaryTetradPermutationCount = utility::factorial(4);
-static constexpr uint32_t PrimaryTetradAndEdgesPermutationCount =
-    EdgePermutationCount * PrimaryTetradPermutationCount;
-static constexpr uint32_t SecondaryTetradPermutationCount =
-    utility::factorial(4) / 6;
+static constexpr uint32_t EvenTetradPermutationCount = utility::factorial(4);
+// each even tetrad permutation is paired with a coset of the Klein four-group
+// in the odd tetrad (see HalfTurnReductionSolver.cpp)
+static constexpr uint32_t OddTetradPermutationCount = 4;
+static constexpr uint32_t CornerPermutationCount =
+    EvenTetradPermutationCount * OddTetradPermutationCount;
 static constexpr uint32_t DescriptorCount =
-    PrimaryTetradAndEdgesPermutationCount * SecondaryTetradPermutationCount;
+    EdgePermutationCount * CornerPermutationCount;
+static constexpr uint32_t SolvedDescriptor = 0;
+
+/**
+ * Edges stay in their slice under half turns, and the slice of the edge at
+ * index i of Cube::EdgeLocationOrder is i % 3 (M, S or E), so the edges are
+ * described by the permutation within each slice.
+ */
+static constexpr uint32_t getEdgeCoordinate(
+    const Permutation<12>& edge_permutation) {
+  std::array<Permutation<4>, 3> slice_permutations;
+  for (uint8_t i = 0; i < edge_permutation.size(); ++i) {
+    assert(edge_permutation[i] % 3 == i % 3);
+    slice_permutations[i % 3][i / 3] = edge_permutation[i] / 3;
+  }
+  assert(slice_permutations[2].isOdd() ==
+         (slice_permutations[0].isOdd() != slice_permutations[1].isOdd()));
+  return slice_permutations[0].getRank() +
+         MSlicePermutationCount * slice_permutations[1].getRank() +
+         MSSlicePermutationCounts * slice_permutations[2].getParityRank();
+}
+
+static constexpr Permutation<12> parseEdgeCoordinate(
+    const uint32_t& edge_coordinate) {
+  const auto m_slice_permutation =
+      Permutation<4>::parseRank(edge_coordinate % MSlicePermutationCount);
+  const auto s_slice_permutation = Permutation<4>::parseRank(
+      (edge_coordinate / MSlicePermutationCount) % SSlicePermutationCount);
+  const auto e_slice_permutation = Permutation<4>::parseParityRank(
+      edge_coordinate / MSSlicePermutationCounts,
+      m_slice_permutation.isOdd() != s_slice_permutation.isOdd());
+  const std::array<Permutation<4>, 3> slice_permutations{
+      m_slice_permutation, s_slice_permutation, e_slice_permutation};
+
+  Permutation<12> edge_permutation;
+  for (uint8_t i = 0; i < edge_permutation.size(); ++i)
+    edge_permutation[i] = 3 * slice_permutations[i % 3][i / 3] + i % 3;
+  assert(edge_permutation.isValid());
+  return edge_permutation;
+}
+
+/**
+ * The corners are described by the permutation of the even tetrad together
+ * with which of the 4 odd tetrad permutations paired with it (which differ by
+ * an element of the Klein four-group) it is. Those 4 permutations each move
+ * the first odd tetrad corner to a different location, so that location is
+ * enough to tell them apart.
+ */
+static constexpr uint32_t getCornerCoordinate(
+    const Permutation<8>& corner_permutation) {
+  Permutation<4> even_tetrad_permutation;
+  uint8_t odd_tetrad_first_corner_index = 0;
+  for (uint8_t i = 0; i < 4; ++i) {
+    assert(corner_permutation[2 * i] % 2 == 0);
+    assert(corner_permutation[2 * i + 1] % 2 == 1);
+    even_tetrad_permutation[i] = corner_permutation[2 * i] / 2;
+    if (corner_permutation[2 * i + 1] == 1) odd_tetrad_first_corner_index = i;
+  }
+  return OddTetradPermutationCount * even_tetrad_permutation.getRank() +
+         odd_tetrad_first_corner_index;
+}
+
+/**
+ * The 96 corner permutations reachable with half turns, stored by their
+ * corner coordinate.
+ */
+static constexpr std::array<Permutation<8>, CornerPermutationCount>
+    HalfTurnCornerPermutations = []() {
+      std::array<Permutation<8>, CornerPermutationCount> corner_permutations{};
+      std::array<bool, CornerPermutationCount> found{};
+      std::vector<Permutation<8>> frontier{Permutation<8>::identity()};
+      found[getCornerCoordinate(frontier.back())] = true;
+      corner_permutations[getCornerCoordinate(frontier.back())] =
+          frontier.back();
+      while (!frontier.empty()) {
+        const Permutation<8> corner_permutation = frontier.back();
+        frontier.pop_back();
+        for (const Turn& turn : HalfTurnReductionPreservingTurns) {
+          Permutation<8> next_corner_permutation = corner_permutation;
+          cycleTurn(next_corner_permutation, getCornerCycle(turn.face),
+                    turn.rotation_amount);
+          const uint32_t corner_coordinate =
+              getCornerCoordinate(next_corner_permutation);
+          if (found[corner_coordinate]) {
+            if (corner_permutations[corner_coordinate] !=
+                next_corner_permutation)
+              throw std::logic_error("Corner coordinate is not unique!");
+            continue;
+          }
+          found[corner_coordinate] = true;
+          corner_permutations[corner_coordinate] = next_corner_permutation;
+          frontier.push_back(next_corner_permutation);
+        }
+      }
+      if (std::find(found.begin(), found.end(), false) != found.end())
+        throw std::logic_error("Corner coordinate is not surjective!");
+      return corner_permutations;
+    }();
 
 static constexpr uint32_t applyTurn(const uint32_t& descriptor,
                                     const Turn& turn) {
   assert(turn.rotation_amount == RotationAmount::HalfTurn);
 
-  Permutation<4> m_slice_permutation =
-      Permutation<4>::parseRank(descriptor % MSlicePermutationCount);
-  Permutation<4> s_slice_permutation = Permutation<4>::parseRank(
-      (descriptor / MSlicePermutationCount) % SSlicePermutationCount);
-  Permutation<4> e_slice_permutation = Permutation<4>::parseParityRank(
-      (descriptor / MSSlicePermutationCounts) % ESlicePermutationCount,
-      m_slice_permutation.isOdd() != s_slice_permutation.isOdd());
-  Permutation<4> primary_tetrad_permutation = Permutation<4>::parseRank(
-      (descriptor / EdgePermutationCount) % PrimaryTetradPermutationCount);
-  // TODO: factor of 3
-  Permutation<4> secondary_tetrad_permutation = Permutation<4>::parseParityRank(
-      descriptor / PrimaryTetradAndEdgesPermutationCount,
-      primary_tetrad_permutation.isOdd());
-
-  return m_slice_permutation.getRank() +
-         MSlicePermutationCount * s_slice_permutation.getRank() +
-         MSSlicePermutationCounts * e_slice_permutation.getParityRank() +
-         EdgePermutationCount * primary_tetrad_permutation.getRank() +
-         PrimaryTetradAndEdgesPermutationCount *
-             secondary_tetrad_permutation.getParityRank() / 3;
+  Permutation<12> edge_permutation =
+      parseEdgeCoordinate(descriptor % EdgePermutationCount);
+  Permutation<8> corner_permutation =
+      HalfTurnCornerPermutations[descriptor / EdgePermutationCount];
+
+  cycleTurn(edge_permutation, getEdgeCycle(turn.face), turn.rotation_amount);
+  cycleTurn(corner_permutation, getCornerCycle(turn.face),
+            turn.rotation_amount);
+
+  return getEdgeCoordinate(edge_permutation) +
+         EdgePermutationCount * getCornerCoordinate(corner_permutation);
 }
 
+/**
+ * Requires the Cube to be half turn reduced.
+ */
 static uint32_t getDescriptor(const Cube& cube) {
-  static constexpr std::array<uint8_t, 12> Mapping{0, 0, 1, 1, 0, 1,
-                                                   2, 3, 2, 3, 3, 2};
-  const auto get_edge_location_index = [](const EdgePiece& edge_piece) {
-    for (size_t i = 0; i < Cube::EDGE_LOCATION_ORDER.size(); ++i)
-      if (edge_piece == Cube::STARTING_EDGE_PIECES[i]) return i;
-    throw std::invalid_argument("EdgePiece was not oriented!");
-  };
-  const auto get_corner_location_index = [](const CornerPiece& corner_piece) {
-    for (size_t i = 0; i < Cube::CORNER_LOCATION_ORDER.size(); ++i)
-      if (corner_piece == Cube::STARTING_CORNER_PIECES[i]) return i;
-    throw std::invalid_argument("CornerPiece was not oriented!");
-  };
+  Permutation<12> edge_permutation;
+  for (uint8_t i = 0; i < edge_permutation.size(); ++i) {
+    const EdgePiece& edge = cube.getEdgeByIndex(i);
+    edge_permutation[i] = std::find(Cube::StartingEdgePieces.begin(),
+                                    Cube::StartingEdgePieces.end(), edge) -
+                          Cube::StartingEdgePieces.begin();
+    if (edge_permutation[i] == Cube::StartingEdgePieces.size())
+      throw std::invalid_argument("EdgePiece was not oriented!");
+  }
+  assert(edge_permutation.isValid());
 
-  Permutation<4> m_slice_permutation;
-  uint8_t i = 0;
-  for (size_t location_index : {0, 2, 8, 10})
-    m_slice_permutation[i++] = Mapping[get_edge_location_index(
-        cube[Cube::EDGE_LOCATION_ORDER[location_index]])];
-  assert(i == m_slice_permutation.size());
-
-  Permutation<4> s_slice_permutation;
-  i = 0;
-  for (size_t location_index : {1, 3, 11, 9})
-    s_slice_permutation[i++] = Mapping[get_edge_location_index(
-        cube[Cube::EDGE_LOCATION_ORDER[location_index]])];
-  assert(i == s_slice_permutation.size());
-
-  Permutation<4> e_slice_permutation;
-  i = 0;
-  for (size_t location_index = 4; location_index < 8; ++location_index)
-    e_slice_permutation[i++] = Mapping[get_edge_location_index(
-        cube[Cube::EDGE_LOCATION_ORDER[location_index]])];
-  assert(i == e_slice_permutation.size());
-
-  Permutation<4> primary_tetrad_permutation;
-  i = 0;
-  for (size_t location_index = 0; location_index < 8; location_index += 2)
-    primary_tetrad_permutation[i++] =
-        get_corner_location_index(
-            cube[Cube::CORNER_LOCATION_ORDER[location_index]]) /
-        2;
-  assert(i == primary_tetrad_permutation.size());
-
-  Permutation<4> secondary_tetrad_permutation;
-  i = 0;
-  for (size_t location_index = 1; location_index < 8; location_index += 2)
-    secondary_tetrad_permutation[i++] =
-        get_corner_location_index(
-            cube[Cube::CORNER_LOCATION_ORDER[location_index]]) /
-        2;
-  assert(i == secondary_tetrad_permutation.size());
-
-  return m_slice_permutation.getRank() +
-         MSlicePermutationCount * s_slice_permutation.getRank() +
-         MSSlicePermutationCounts * e_slice_permutation.getParityRank() +
-         EdgePermutationCount * primary_tetrad_permutation.getRank() +
-         PrimaryTetradAndEdgesPermutationCount *
-             secondary_tetrad_permutation.getParityRank() / 3;
+  Permutation<8> corner_permutation;
+  for (uint8_t i = 0; i < corner_permutation.size(); ++i) {
+    const CornerPiece& corner = cube.getCornerByIndex(i);
+    corner_permutation[i] = std::find(Cube::StartingCornerPieces.begin(),
+                                      Cube::StartingCornerPieces.end(),
+                                      corner) -
+                            Cube::StartingCornerPieces.begin();
+    if (corner_permutation[i] == Cube::StartingCornerPieces.size())
+      throw std::invalid_argument("CornerPiece was not oriented!");
+  }
+  assert(corner_permutation.isValid());
+
+  return getEdgeCoordinate(edge_permutation) +
+         EdgePermutationCount * getCornerCoordinate(corner_permutation);
+}
+
+Algorithm ThistlethwaiteSolve::getAlgorithm() const {
+  Algorithm alg;
+  for (const ThistlethwaiteStage& stage : stages)
+    alg.insert(alg.end(), stage.solve.begin(), stage.solve.end());
+  return alg;
 }
 
-Algorithm solveThistlethwaite(Cube cube) {
-  static constexpr auto solver =
-      getSolver<DescriptorCount, HalfTurnReductionPreservingTurns, applyTurn,
-                SolvedDescriptor>();
+static constexpr char LookupTableFileName[] =
+    "./lookup_tables/ThistlethwaiteLookupTable.bin";
 
-  const Algorithm half_turn_reduction_solve = solveHalfTurnReduction(cube);
-  cube.apply(half_turn_reduction_solve);
-  return half_turn_reduction_solve + solver(getDescriptor(cube));
+ThistlethwaiteSolve solveThistlethwaiteStages(const Cube& cube) {
+  // too large to evaluate at compile time, so built on first use instead
+  static const auto solver =
+      getRuntimeSolver<DescriptorCount, HalfTurnReductionPreservingTurns,
+                       applyTurn, SolvedDescriptor>(LookupTableFileName);
+
+  ThistlethwaiteSolve solve;
+  // each stage solver also solves the earlier stages, which are already
+  // solved when it is called and so add no moves. The TrackedCube keeps the
+  // descriptors of the stages up to date, so no stage recomputes its
+  // descriptor from the pieces.
+  TrackedCube stage_cube{cube};
+  const auto solve_stage = [&](ThistlethwaiteStage& stage, const char* name,
+                               const auto& solve_cube) {
+    const auto t_start = std::chrono::steady_clock::now();
+    stage = {name, solve_cube(stage_cube), {}};
+    stage.duration = std::chrono::steady_clock::now() - t_start;
+    stage_cube.apply(stage.solve);
+  };
+  solve_stage(solve.stages[0], "EO",
+              [](const TrackedCube& c) { return solveEdgeOrientation(c); });
+  solve_stage(solve.stages[1], "DR",
+              [](const TrackedCube& c) { return solveDominoReduction(c); });
+  solve_stage(solve.stages[2], "HTR",
+              [](const TrackedCube& c) { return solveHalfTurnReduction(c); });
+  solve_stage(solve.stages[3], "Solved", [](const TrackedCube& c) {
+    return solver(getDescriptor(c.getCube()));
+  });
+  assert(stage_cube.getCube().isSolved());
+  return solve;
 }
 
-void testIsSolved() {
+Algorithm solveThistlethwaite(const Cube& cube) {
+  return solveThistlethwaiteStages(cube).getAlgorithm();
+}
+
+// Test functions
+
+static void testIsSolved() {
   // Should be identical to cube.isSolved()
   const auto is_solved = [](const Cube& cube) {
     return isHalfTurnReduced(cube) && getDescriptor(cube) == SolvedDescriptor;
@@ -139,11 +245,35 @@ void testIsSolved() {
   static constexpr size_t Count = 1000;
 
   for (size_t i = 0; i < Count; ++i) {
-    const Cube cube = Cube{Algorithm::random(20)};
+    const Cube cube{Algorithm::random(20, HalfTurnReductionPreservingTurns)};
     if (is_solved(cube) != cube.isSolved())
       throw std::logic_error("isSolved disagreement!");
   }
 }
 
-void runThistlethwaiteSolverTests() { testIsSolved(); }
+static void testApplyTurn() {
+  for (const Turn& turn : HalfTurnReductionPreservingTurns) {
+    Algorithm alg;
+    alg.push_back(Move{turn});
+    if (applyTurn(SolvedDescriptor, turn) != getDescriptor(Cube{alg}))
+      throw std::logic_error("Descriptor mismatch!");
+  }
+
+  static constexpr size_t Count = 1000;
+
+  for (size_t i = 0; i < Count; ++i) {
+    const Algorithm alg =
+        Algorithm::random(20, HalfTurnReductionPreservingTurns);
+    uint32_t descriptor = SolvedDescriptor;
+    for (const Move& move : alg)
+      descriptor = applyTurn(descriptor, move.getTurn());
+    if (descriptor != getDescriptor(Cube{alg}))
+      throw std::logic_error("Descriptor mismatch!");
+  }
+}
+
+void runThistlethwaiteSolverTests() {
+  testIsSolved();
+  testApplyTurn();
+}
 }  // namespace solvers
@@ -0,0 +1,75 @@
+#include "TrackedCube.h"
+#include "Algorithm.h"
+#include "CubeOrientation.h"
+#include "CubeRotation.h"
+#include "DominoReductionSolver.h"
+#include "EdgeOrientationSolver.h"
+#include "HalfTurnReductionSolver.h"
+#include "Move.h"
+#include "RotationAmount.h"
+#include "SliceTurn.h"
+#include "Turn.h"
+#include "WideTurn.h"
+#include <cassert>
+
+namespace solvers {
+TrackedCube::TrackedCube(const Cube& cube)
+    : cube(cube),
+      edge_orientation_descriptor(
+          solvers::getEdgeOrientationDescriptor(cube)),
+      domino_reduction_descriptor(
+          solvers::getDominoReductionDescriptor(cube)) {
+  is_domino_reduced = isDominoReduced(*this);
+  if (is_domino_reduced)
+    half_turn_reduction_descriptor =
+        solvers::getHalfTurnReductionDescriptor(cube);
+}
+
+void TrackedCube::apply(const Turn& turn) {
+  if (turn.rotation_amount == RotationAmount::None) return;
+
+  // the descriptors describe the pieces, which the Cube turns relative to its
+  // orientation
+  const Turn oriented_turn = cube.getOrientation().apply(turn);
+  cube.apply(turn);
+  edge_orientation_descriptor =
+      applyEdgeOrientationTurn(edge_orientation_descriptor, oriented_turn);
+  domino_reduction_descriptor =
+      applyDominoReductionTurn(domino_reduction_descriptor, oriented_turn);
+
+  // a Turn from a domino reduced Cube to a domino reduced Cube preserves
+  // domino reduction, so the half turn reduction descriptor can be updated
+  const bool was_domino_reduced = is_domino_reduced;
+  is_domino_reduced = isDominoReduced(*this);
+  if (is_domino_reduced && was_domino_reduced)
+    half_turn_reduction_descriptor =
+        applyHalfTurnReductionTurn(half_turn_reduction_descriptor,
+                                   oriented_turn);
+  else if (is_domino_reduced)
+    half_turn_reduction_descriptor =
+        solvers::getHalfTurnReductionDescriptor(cube);
+}
+
+void TrackedCube::apply(const Move& move) {
+  if (move.isTurn())
+    apply(move.getTurn());
+  else if (move.isSliceTurn()) {
+    const auto [turn1, turn2, cube_rotation] = move.getSliceTurn().expand();
+    apply(turn1);
+    apply(turn2);
+    cube.apply(cube_rotation);
+  } else if (move.isWideTurn()) {
+    const auto [turn, cube_rotation] = move.getWideTurn().expand();
+    apply(turn);
+    cube.apply(cube_rotation);
+  } else {
+    // rotations do not move any pieces
+    assert(move.isCubeRotation());
+    cube.apply(move.getCubeRotation());
+  }
+}
+
+void TrackedCube::apply(const Algorithm& algorithm) {
+  for (const Move& move : algorithm) apply(move);
+}
+}  // namespace solvers
@@ -0,0 +1,831 @@
+#include "TwoPhaseSolver.h"
+#include "Algorithm.h"
+#include "Colour.h"
+#include "Combination.h"
+#include "CornerLocation.h"
+#include "CornerPiece.h"
+#include "CornerRotationAmount.h"
+#include "Cube.h"
+#include "CubeOrientation.h"
+#include "CubieCube.h"
+#include "EdgeLocation.h"
+#include "EdgePiece.h"
+#include "Face.h"
+#include "MathUtils.h"
+#include "Move.h"
+#include "PackedBitsArray.h"
+#include "Permutation.h"
+#include "RotationAmount.h"
+#include "SolverUtils.h"
+#include "Turn.h"
+#include "TurnSets.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace solvers {
+static constexpr uint32_t FlipCount = 2048;  // 2^11
+static constexpr uint32_t TwistCount = utility::PowersOf3[7];
+static constexpr uint32_t SliceCount = utility::nChooseK(12, 4);
+static constexpr uint32_t CornerPermutationCount = 40320;  // 8!
+static constexpr uint32_t EdgePermutationCount = 40320;    // 8!
+static constexpr uint32_t SlicePermutationCount = 24;      // 4!
+
+/**
+ * The E slice edge slots, sorted so that they form a Combination<12, 4>.
+ */
+static constexpr std::array<uint8_t, 4> SliceEdges = []() {
+  std::array<uint8_t, 4> slice_edges{
+      getEdgeIndex(Face::F, Face::R), getEdgeIndex(Face::B, Face::R),
+      getEdgeIndex(Face::B, Face::L), getEdgeIndex(Face::F, Face::L)};
+  std::sort(slice_edges.begin(), slice_edges.end());
+  return slice_edges;
+}();
+
+/**
+ * The remaining (U and D layer) edge slots, in increasing order.
+ */
+static constexpr std::array<uint8_t, 8> UDEdges = []() {
+  std::array<uint8_t, 8> ud_edges{};
+  uint8_t i = 0;
+  for (uint8_t edge = 0; edge < CubieCube::EdgeCount; ++edge)
+    if (std::find(SliceEdges.begin(), SliceEdges.end(), edge) ==
+        SliceEdges.end())
+      ud_edges[i++] = edge;
+  return ud_edges;
+}();
+
+/**
+ * The index of each edge slot within SliceEdges or UDEdges.
+ */
+static constexpr std::array<uint8_t, 12> EdgeRanks = []() {
+  std::array<uint8_t, 12> edge_ranks{};
+  for (uint8_t i = 0; i < SliceEdges.size(); ++i)
+    edge_ranks[SliceEdges[i]] = i;
+  for (uint8_t i = 0; i < UDEdges.size(); ++i) edge_ranks[UDEdges[i]] = i;
+  return edge_ranks;
+}();
+
+static constexpr bool isSliceEdge(const uint8_t& edge) {
+  return std::find(SliceEdges.begin(), SliceEdges.end(), edge) !=
+         SliceEdges.end();
+}
+
+static constexpr uint32_t SolvedSlice = []() {
+  Combination<12, 4> slice;
+  std::copy(SliceEdges.begin(), SliceEdges.end(), slice.begin());
+  return slice.getRank();
+}();
+
+// Phase 1 coordinates, laid out like the DominoReductionSolver descriptor
+
+static constexpr uint32_t FlipSliceCount = SliceCount * FlipCount;
+static constexpr uint32_t SolvedFlipSlice = SolvedSlice * FlipCount;
+static constexpr uint32_t TwistSliceCount = SliceCount * TwistCount;
+static constexpr uint32_t SolvedTwistSlice = SolvedSlice * TwistCount;
+
+// Phase 2 coordinates
+
+static constexpr uint32_t CornerSlicePermutationCount =
+    SlicePermutationCount * CornerPermutationCount;
+static constexpr uint32_t EdgeSlicePermutationCount =
+    SlicePermutationCount * EdgePermutationCount;
+
+static uint16_t getFlip(const CubieCube& cube) {
+  uint16_t flip = 0;
+  for (uint8_t i = 0; i < CubieCube::EdgeCount - 1; ++i)
+    flip |= cube.isEdgeFlipped(i) << i;
+  return flip;
+}
+
+static uint16_t getTwist(const CubieCube& cube) {
+  uint16_t twist = 0;
+  for (size_t i = 0; i < CubieCube::CornerCount - 1; ++i)
+    twist += static_cast<uint8_t>(cube.getCornerRotation(i)) *
+             utility::PowersOf3[i];
+  return twist;
+}
+
+static uint16_t getSlice(const CubieCube& cube) {
+  Combination<12, 4> slice;
+  uint8_t i = 0;
+  for (uint8_t edge = 0; edge < CubieCube::EdgeCount; ++edge)
+    if (isSliceEdge(cube.getEdgePiece(edge))) slice[i++] = edge;
+  assert(i == slice.size());
+  return slice.getRank();
+}
+
+static uint16_t getCornerPermutation(const CubieCube& cube) {
+  Permutation<8> corner_permutation;
+  for (uint8_t i = 0; i < CubieCube::CornerCount; ++i)
+    corner_permutation[i] = cube.getCornerPiece(i);
+  return corner_permutation.getRank();
+}
+
+/**
+ * Only valid if the U and D layer edges are in the U and D layers.
+ */
+static uint16_t getEdgePermutation(const CubieCube& cube) {
+  Permutation<8> edge_permutation;
+  for (uint8_t i = 0; i < UDEdges.size(); ++i)
+    edge_permutation[i] = EdgeRanks[cube.getEdgePiece(UDEdges[i])];
+  assert(edge_permutation.isValid());
+  return edge_permutation.getRank();
+}
+
+/**
+ * Only valid if the E slice edges are in the E slice.
+ */
+static uint16_t getSlicePermutation(const CubieCube& cube) {
+  Permutation<4> slice_permutation;
+  for (uint8_t i = 0; i < SliceEdges.size(); ++i)
+    slice_permutation[i] = EdgeRanks[cube.getEdgePiece(SliceEdges[i])];
+  assert(slice_permutation.isValid());
+  return slice_permutation.getRank();
+}
+
+static CubieCube fromFlip(const uint16_t& flip) {
+  std::array<uint8_t, 16> edges = CubieCube{}.getEdges();
+  bool is_odd = false;
+  for (uint8_t i = 0; i < CubieCube::EdgeCount - 1; ++i) {
+    if ((flip >> i) & 1) {
+      edges[i] |= 1;
+      is_odd = !is_odd;
+    }
+  }
+  if (is_odd) edges[CubieCube::EdgeCount - 1] |= 1;
+  return CubieCube{edges, CubieCube{}.getCorners()};
+}
+
+static CubieCube fromTwist(const uint16_t& twist) {
+  std::array<uint8_t, 8> corners = CubieCube{}.getCorners();
+  CornerRotationAmount total_rotation = CornerRotationAmount::None;
+  for (uint8_t i = 0; i < CubieCube::CornerCount - 1; ++i) {
+    const auto rotation =
+        static_cast<CornerRotationAmount>((twist / utility::PowersOf3[i]) % 3);
+    corners[i] |= static_cast<uint8_t>(rotation);
+    total_rotation += rotation;
+  }
+  corners[CubieCube::CornerCount - 1] |=
+      static_cast<uint8_t>(-total_rotation);
+  return CubieCube{CubieCube{}.getEdges(), corners};
+}
+
+static CubieCube fromSlice(const uint16_t& slice_rank) {
+  const auto slice = Combination<12, 4>::parseRank(slice_rank);
+  std::array<uint8_t, 16> edges{};
+  uint8_t slice_idx = 0;
+  uint8_t ud_idx = 0;
+  for (uint8_t edge = 0; edge < CubieCube::EdgeCount; ++edge) {
+    if (slice_idx < slice.size() && slice[slice_idx] == edge)
+      edges[edge] = SliceEdges[slice_idx++] << 4;
+    else
+      edges[edge] = UDEdges[ud_idx++] << 4;
+  }
+  return CubieCube{edges, CubieCube{}.getCorners()};
+}
+
+static CubieCube fromCornerPermutation(const uint16_t& rank) {
+  const auto corner_permutation = Permutation<8>::parseRank(rank);
+  std::array<uint8_t, 8> corners{};
+  for (uint8_t i = 0; i < CubieCube::CornerCount; ++i)
+    corners[i] = corner_permutation[i] << 4;
+  return CubieCube{CubieCube{}.getEdges(), corners};
+}
+
+static CubieCube fromEdgePermutation(const uint16_t& rank) {
+  const auto edge_permutation = Permutation<8>::parseRank(rank);
+  std::array<uint8_t, 16> edges = CubieCube{}.getEdges();
+  for (uint8_t i = 0; i < UDEdges.size(); ++i)
+    edges[UDEdges[i]] = UDEdges[edge_permutation[i]] << 4;
+  return CubieCube{edges, CubieCube{}.getCorners()};
+}
+
+static CubieCube fromSlicePermutation(const uint16_t& rank) {
+  const auto slice_permutation = Permutation<4>::parseRank(rank);
+  std::array<uint8_t, 16> edges = CubieCube{}.getEdges();
+  for (uint8_t i = 0; i < SliceEdges.size(); ++i)
+    edges[SliceEdges[i]] = SliceEdges[slice_permutation[i]] << 4;
+  return CubieCube{edges, CubieCube{}.getCorners()};
+}
+
+/**
+ * Applies a Turn to a coordinate by building a CubieCube with that coordinate,
+ * which is slow, so it is only used to fill the MoveTables.
+ */
+template <auto fromCoordinate, auto getCoordinate>
+static uint32_t applyCubieCubeTurn(const uint32_t& coordinate,
+                                   const Turn& turn) {
+  CubieCube cube = fromCoordinate(static_cast<uint16_t>(coordinate));
+  assert(getCoordinate(cube) == coordinate);
+  cube.apply(turn);
+  return getCoordinate(cube);
+}
+
+using FlipSliceMoveTable =
+    ProductMoveTable<SliceCount, FlipCount, AllPossibleTurns,
+                     applyCubieCubeTurn<fromSlice, getSlice>,
+                     applyCubieCubeTurn<fromFlip, getFlip>>;
+using TwistSliceMoveTable =
+    ProductMoveTable<SliceCount, TwistCount, AllPossibleTurns,
+                     applyCubieCubeTurn<fromSlice, getSlice>,
+                     applyCubieCubeTurn<fromTwist, getTwist>>;
+using TwistFlipMoveTable =
+    ProductMoveTable<TwistCount, FlipCount, AllPossibleTurns,
+                     applyCubieCubeTurn<fromTwist, getTwist>,
+                     applyCubieCubeTurn<fromFlip, getFlip>>;
+using CornerSlicePermutationMoveTable = ProductMoveTable<
+    SlicePermutationCount, CornerPermutationCount,
+    DominoReductionPreservingTurns,
+    applyCubieCubeTurn<fromSlicePermutation, getSlicePermutation>,
+    applyCubieCubeTurn<fromCornerPermutation, getCornerPermutation>>;
+using EdgeSlicePermutationMoveTable = ProductMoveTable<
+    SlicePermutationCount, EdgePermutationCount,
+    DominoReductionPreservingTurns,
+    applyCubieCubeTurn<fromSlicePermutation, getSlicePermutation>,
+    applyCubieCubeTurn<fromEdgePermutation, getEdgePermutation>>;
+
+static constexpr size_t Phase1TurnCount = AllPossibleTurns.size();
+static constexpr size_t Phase2TurnCount = DominoReductionPreservingTurns.size();
+
+/**
+ * The search tracks each coordinate separately, while the pruning tables are
+ * indexed by the products, which share the slice and slice permutation tables.
+ */
+struct MoveTables {
+  FlipSliceMoveTable::MinorMoveTable flip;
+  TwistSliceMoveTable::MinorMoveTable twist;
+  FlipSliceMoveTable::MajorMoveTable slice;
+  CornerSlicePermutationMoveTable::MinorMoveTable corner_permutation;
+  EdgeSlicePermutationMoveTable::MinorMoveTable edge_permutation;
+  CornerSlicePermutationMoveTable::MajorMoveTable slice_permutation;
+
+  FlipSliceMoveTable flip_slice{slice, flip};
+  TwistFlipMoveTable twist_flip{twist, flip};
+  TwistSliceMoveTable twist_slice{slice, twist};
+  CornerSlicePermutationMoveTable corner_slice_permutation{slice_permutation,
+                                                           corner_permutation};
+  EdgeSlicePermutationMoveTable edge_slice_permutation{slice_permutation,
+                                                       edge_permutation};
+};
+
+static const MoveTables& getMoveTables() {
+  static const MoveTables move_tables{};
+  return move_tables;
+}
+
+static uint32_t applyFlipSliceTurn(const uint32_t& descriptor,
+                                   const Turn& turn) {
+  return getMoveTables().flip_slice.apply(descriptor, turn);
+}
+
+static uint32_t applyTwistSliceTurn(const uint32_t& descriptor,
+                                    const Turn& turn) {
+  return getMoveTables().twist_slice.apply(descriptor, turn);
+}
+
+static uint32_t applyTwistFlipTurn(const uint32_t& descriptor,
+                                   const Turn& turn) {
+  return getMoveTables().twist_flip.apply(descriptor, turn);
+}
+
+static uint32_t applyCornerSlicePermutationTurn(const uint32_t& descriptor,
+                                                const Turn& turn) {
+  return getMoveTables().corner_slice_permutation.apply(descriptor, turn);
+}
+
+static uint32_t applyEdgeSlicePermutationTurn(const uint32_t& descriptor,
+                                              const Turn& turn) {
+  return getMoveTables().edge_slice_permutation.apply(descriptor, turn);
+}
+
+template <uint32_t DescriptorCount>
+using PruningTable = utility::PackedBitsArray<2, DescriptorCount, true>;
+
+struct PruningTables {
+  PruningTable<FlipSliceCount> flip_slice;
+  PruningTable<TwistSliceCount> twist_slice;
+  PruningTable<TwistCount * FlipCount> twist_flip;
+  PruningTable<CornerSlicePermutationCount> corner_slice_permutation;
+  PruningTable<EdgeSlicePermutationCount> edge_slice_permutation;
+};
+
+/**
+ * Not constexpr, since otherwise the compiler attempts to constant-initialize
+ * the static tables in getPruningTables, filling each table at compile time
+ * before failing on the first (non-constexpr) applyTurn.
+ */
+static PruningTables generatePruningTables() {
+  return {detail::getPruningTable<FlipSliceCount, AllPossibleTurns,
+                                  applyFlipSliceTurn, SolvedFlipSlice, true>(),
+          detail::getPruningTable<TwistSliceCount, AllPossibleTurns,
+                                  applyTwistSliceTurn, SolvedTwistSlice,
+                                  true>(),
+          detail::getPruningTable<TwistCount * FlipCount, AllPossibleTurns,
+                                  applyTwistFlipTurn, 0u, true>(),
+          detail::getPruningTable<CornerSlicePermutationCount,
+                                  DominoReductionPreservingTurns,
+                                  applyCornerSlicePermutationTurn, 0u, true>(),
+          detail::getPruningTable<EdgeSlicePermutationCount,
+                                  DominoReductionPreservingTurns,
+                                  applyEdgeSlicePermutationTurn, 0u, true>()};
+}
+
+static const PruningTables& getPruningTables() {
+  static const PruningTables pruning_tables = generatePruningTables();
+  return pruning_tables;
+}
+
+/**
+ * @brief Since neighbouring descriptors are at most one move apart, the exact
+ * distance of a neighbour follows from the exact distance of the descriptor
+ * and the neighbour's pruning table value (its distance mod 3).
+ */
+static constexpr uint8_t getNeighbourDistance(const uint8_t& distance,
+                                              const uint8_t& neighbour_value) {
+  switch ((neighbour_value + 3 - distance % 3) % 3) {
+    case 0:
+      return distance;
+    case 1:
+      return distance + 1;
+    default:
+      assert(distance > 0);
+      return distance - 1;
+  }
+}
+
+static_assert(getNeighbourDistance(4, 0) == 3 &&
+              getNeighbourDistance(4, 1) == 4 &&
+              getNeighbourDistance(4, 2) == 5);
+
+/**
+ * @return Whether a Turn on face should be skipped after a Turn on
+ * previous_face, since the two could be combined into one Turn or commute.
+ */
+static constexpr bool isRedundant(const Face& face, const Face& previous_face) {
+  return face == previous_face ||
+         (face == getOpposite(previous_face) && face < previous_face);
+}
+
+static constexpr bool isDominoReductionPreserving(const Turn& turn) {
+  return TurnIndices<DominoReductionPreservingTurns>[getTurnTableIndex(
+             turn)] != Phase2TurnCount;
+}
+
+// each Face has the Colour of its centre, which shares its enumerator index
+static_assert([]() {
+  for (size_t i = 0; i < Cube::EdgeLocationOrder.size(); ++i)
+    if (static_cast<Face>(Cube::StartingEdgePieces[i].first) !=
+            Cube::EdgeLocationOrder[i].first ||
+        static_cast<Face>(Cube::StartingEdgePieces[i].second) !=
+            Cube::EdgeLocationOrder[i].second)
+      return false;
+  return true;
+}());
+
+/**
+ * @return The Cube rotated by the given CubeOrientation together with its
+ * pieces' colours, so that applying orientation.apply(turn) to it mirrors
+ * applying turn to the given Cube.
+ */
+static CubieCube getConjugate(const CubieCube& cube,
+                              const CubeOrientation& orientation) {
+  const auto apply = [&](const Colour& colour) {
+    return static_cast<Colour>(orientation.apply(static_cast<Face>(colour)));
+  };
+  const Cube pieces = cube.toCube();
+  Cube conjugate{};
+  for (const EdgeLocation& location : Cube::EdgeLocationOrder) {
+    const EdgePiece piece = pieces[location];
+    conjugate[EdgeLocation{orientation.apply(location.first),
+                           orientation.apply(location.second)}] =
+        EdgePiece{apply(piece.first), apply(piece.second)};
+  }
+  for (const CornerLocation& location : Cube::CornerLocationOrder) {
+    const CornerPiece piece = pieces[location];
+    conjugate[CornerLocation{orientation.apply(location.first),
+                             orientation.apply(location.second),
+                             orientation.apply(location.third)}] =
+        CornerPiece{apply(piece.first), apply(piece.second),
+                    apply(piece.third)};
+  }
+  return CubieCube{conjugate};
+}
+
+/**
+ * @return The Cube that the inverse of any scramble of the given Cube leads
+ * to, which the inverse of any of its solves solves.
+ */
+static CubieCube getInverse(const CubieCube& cube) {
+  std::array<uint8_t, 16> edges{};
+  for (uint8_t i = 0; i < CubieCube::EdgeCount; ++i)
+    edges[cube.getEdgePiece(i)] = (i << 4) | cube.isEdgeFlipped(i);
+  std::array<uint8_t, 8> corners{};
+  for (uint8_t i = 0; i < CubieCube::CornerCount; ++i)
+    corners[cube.getCornerPiece(i)] =
+        (i << 4) | static_cast<uint8_t>(-cube.getCornerRotation(i));
+  return CubieCube{edges, corners};
+}
+
+/**
+ * Phase 1 reduces to domino reduction about the U and D axis, so the Cube is
+ * also searched rotated to each of the other axes, as well as inverted, since
+ * some of these take much fewer nodes to find a short solve than others.
+ */
+static constexpr std::array<CubeOrientation, 3> SearchOrientations{
+    {{Face::U, Face::F}, {Face::F, Face::U}, {Face::R, Face::F}}};
+
+class TwoPhaseSearch {
+ private:
+  static constexpr size_t MaxPhase1Length = 12;
+  static constexpr size_t MaxPhase2Length = 18;
+  static constexpr size_t MaxBoundedPhase2Length = 12;
+  static constexpr size_t UnknownLength = std::numeric_limits<size_t>::max();
+
+  const MoveTables& move_tables = getMoveTables();
+  const PruningTables& pruning_tables = getPruningTables();
+
+  /**
+   * A Cube searched in place of the Cube being solved, with its phase 1
+   * coordinates and their distances to domino reduction.
+   */
+  struct Direction {
+    CubieCube cube;
+    CubeOrientation orientation;
+    bool is_inverse;
+    uint16_t flip;
+    uint16_t twist;
+    uint16_t slice;
+    uint8_t flip_slice_distance;
+    uint8_t twist_slice_distance;
+    uint8_t twist_flip_distance;
+  };
+
+  std::vector<Direction> directions;
+  const Direction* direction = nullptr;  // the Direction being searched
+  const size_t max_length;
+  const std::chrono::steady_clock::time_point deadline;
+
+  // indices into AllPossibleTurns and DominoReductionPreservingTurns
+  std::array<uint8_t, MaxPhase1Length> phase1_turns{};
+  std::array<uint8_t, MaxPhase2Length> phase2_turns{};
+
+  std::vector<Turn> best_solve;
+  size_t best_length = UnknownLength;
+  bool is_done = false;
+  // until a solve is found, whether phase 2 only looks for solves of at most
+  // max_length moves
+  bool is_bounded;
+
+ public:
+  TwoPhaseSearch(const CubieCube& cube, const size_t& max_length,
+                 const std::chrono::steady_clock::time_point& deadline)
+      : max_length(max_length),
+        deadline(deadline),
+        is_bounded(max_length > 0) {
+    for (const CubeOrientation& orientation : SearchOrientations) {
+      const CubieCube conjugate = getConjugate(cube, orientation);
+      addDirection(conjugate, orientation, false);
+      addDirection(getInverse(conjugate), orientation, true);
+    }
+  }
+
+  std::vector<Turn> search() {
+    searchDirections();
+    // there is no solve of at most max_length moves with a phase 1 of at most
+    // MaxPhase1Length moves, so settle for any solve
+    if (best_length == UnknownLength) {
+      is_bounded = false;
+      searchDirections();
+    }
+    assert(best_length != UnknownLength);
+    return best_solve;
+  }
+
+ private:
+  /**
+   * Searches every Direction to each phase 1 length before any is searched
+   * further, so the search stops at the Direction with the shortest solve.
+   */
+  void searchDirections() {
+    for (size_t length = 0;
+         length <= MaxPhase1Length && length < best_length && !is_done;
+         ++length) {
+      for (const Direction& next_direction : directions) {
+        if (std::max({next_direction.flip_slice_distance,
+                      next_direction.twist_slice_distance,
+                      next_direction.twist_flip_distance}) > length)
+          continue;
+        direction = &next_direction;
+        searchPhase1(direction->flip, direction->twist, direction->slice,
+                     direction->flip_slice_distance,
+                     direction->twist_slice_distance,
+                     direction->twist_flip_distance, 0, length);
+        if (is_done || length >= best_length) break;
+      }
+    }
+  }
+
+  void addDirection(const CubieCube& cube, const CubeOrientation& orientation,
+                    const bool& is_inverse) {
+    const uint16_t flip = getFlip(cube);
+    const uint16_t twist = getTwist(cube);
+    const uint16_t slice = getSlice(cube);
+    directions.push_back(
+        {cube, orientation, is_inverse, flip, twist, slice,
+         static_cast<uint8_t>(
+             solveWithPruningTable<FlipSliceCount, AllPossibleTurns,
+                                   applyFlipSliceTurn, SolvedFlipSlice>(
+                 pruning_tables.flip_slice, slice * FlipCount + flip)
+                 .size()),
+         static_cast<uint8_t>(
+             solveWithPruningTable<TwistSliceCount, AllPossibleTurns,
+                                   applyTwistSliceTurn, SolvedTwistSlice>(
+                 pruning_tables.twist_slice, slice * TwistCount + twist)
+                 .size()),
+         static_cast<uint8_t>(
+             solveWithPruningTable<TwistCount * FlipCount, AllPossibleTurns,
+                                   applyTwistFlipTurn, 0u>(
+                 pruning_tables.twist_flip, twist * FlipCount + flip)
+                 .size())});
+  }
+
+  void searchPhase1(const uint16_t& flip, const uint16_t& twist,
+                    const uint16_t& slice, const uint8_t& flip_slice_distance,
+                    const uint8_t& twist_slice_distance,
+                    const uint8_t& twist_flip_distance, const size_t& depth,
+                    const size_t& remaining) {
+    if (remaining == 0) {
+      // a phase 1 solve ending in a phase 2 Turn would have been found as a
+      // shorter phase 1 solve
+      if (flip_slice_distance == 0 && twist_slice_distance == 0 &&
+          (depth == 0 || !isDominoReductionPreserving(
+                             AllPossibleTurns[phase1_turns[depth - 1]])))
+        startPhase2(depth);
+      return;
+    }
+
+    for (uint8_t i = 0; i < Phase1TurnCount; ++i) {
+      const Turn& turn = AllPossibleTurns[i];
+      if (depth > 0 &&
+          isRedundant(turn.face,
+                      AllPossibleTurns[phase1_turns[depth - 1]].face))
+        continue;
+
+      const uint16_t next_flip = move_tables.flip(flip, i);
+      const uint16_t next_slice = move_tables.slice(slice, i);
+      const uint8_t next_flip_slice_distance = getNeighbourDistance(
+          flip_slice_distance,
+          pruning_tables.flip_slice[next_slice * FlipCount + next_flip]);
+      if (next_flip_slice_distance >= remaining) continue;
+      const uint16_t next_twist = move_tables.twist(twist, i);
+      const uint8_t next_twist_slice_distance = getNeighbourDistance(
+          twist_slice_distance,
+          pruning_tables.twist_slice[next_slice * TwistCount + next_twist]);
+      if (next_twist_slice_distance >= remaining) continue;
+      const uint8_t next_twist_flip_distance = getNeighbourDistance(
+          twist_flip_distance,
+          pruning_tables.twist_flip[next_twist * FlipCount + next_flip]);
+      if (next_twist_flip_distance >= remaining) continue;
+
+      phase1_turns[depth] = i;
+      searchPhase1(next_flip, next_twist, next_slice, next_flip_slice_distance,
+                   next_twist_slice_distance, next_twist_flip_distance,
+                   depth + 1, remaining - 1);
+      if (is_done) return;
+    }
+  }
+
+  void startPhase2(const size_t& phase1_length) {
+    if (best_length != UnknownLength) {
+      if (std::chrono::steady_clock::now() > deadline) {
+        is_done = true;
+        return;
+      }
+      // a shorter solve may have been found since this phase 1 search began
+      if (phase1_length >= best_length) return;
+    } else if (is_bounded) {
+      // once the timeout has passed, any solve will do
+      if (std::chrono::steady_clock::now() > deadline)
+        is_bounded = false;
+      else if (phase1_length > max_length)
+        return;
+    }
+
+    CubieCube phase2_cube = direction->cube;
+    for (size_t i = 0; i < phase1_length; ++i)
+      phase2_cube.apply(AllPossibleTurns[phase1_turns[i]]);
+    const uint16_t corner_permutation = getCornerPermutation(phase2_cube);
+    const uint16_t edge_permutation = getEdgePermutation(phase2_cube);
+    const uint16_t slice_permutation = getSlicePermutation(phase2_cube);
+    const auto corner_distance = static_cast<uint8_t>(
+        solveWithPruningTable<CornerSlicePermutationCount,
+                              DominoReductionPreservingTurns,
+                              applyCornerSlicePermutationTurn, 0u>(
+            pruning_tables.corner_slice_permutation,
+            slice_permutation * CornerPermutationCount + corner_permutation)
+            .size());
+    const auto edge_distance = static_cast<uint8_t>(
+        solveWithPruningTable<EdgeSlicePermutationCount,
+                              DominoReductionPreservingTurns,
+                              applyEdgeSlicePermutationTurn, 0u>(
+            pruning_tables.edge_slice_permutation,
+            slice_permutation * EdgePermutationCount + edge_permutation)
+            .size());
+
+    // only look for strictly shorter solves, and while bounded for short
+    // solves of at most max_length moves, since deep phase 2 searches take
+    // most of the time and a longer phase 1 solve is soon found instead
+    size_t max_phase2_length = MaxPhase2Length;
+    if (best_length != UnknownLength)
+      max_phase2_length =
+          std::min(MaxPhase2Length, best_length - phase1_length - 1);
+    else if (is_bounded)
+      max_phase2_length =
+          std::min(MaxBoundedPhase2Length, max_length - phase1_length);
+    for (size_t length = std::max(corner_distance, edge_distance);
+         length <= max_phase2_length; ++length) {
+      if (searchPhase2(corner_permutation, edge_permutation, slice_permutation,
+                       corner_distance, edge_distance, phase1_length, 0,
+                       length)) {
+        recordSolve(phase1_length, length);
+        return;
+      }
+    }
+  }
+
+  bool searchPhase2(const uint16_t& corner_permutation,
+                    const uint16_t& edge_permutation,
+                    const uint16_t& slice_permutation,
+                    const uint8_t& corner_distance,
+                    const uint8_t& edge_distance, const size_t& phase1_length,
+                    const size_t& depth, const size_t& remaining) {
+    if (remaining == 0) return corner_distance == 0 && edge_distance == 0;
+
+    std::optional<Face> previous_face;
+    if (depth > 0)
+      previous_face =
+          DominoReductionPreservingTurns[phase2_turns[depth - 1]].face;
+    else if (phase1_length > 0)
+      previous_face = AllPossibleTurns[phase1_turns[phase1_length - 1]].face;
+    for (uint8_t i = 0; i < Phase2TurnCount; ++i) {
+      const Turn& turn = DominoReductionPreservingTurns[i];
+      if (previous_face && isRedundant(turn.face, *previous_face)) continue;
+
+      const uint16_t next_slice_permutation =
+          move_tables.slice_permutation(slice_permutation, i);
+      const uint16_t next_corner_permutation =
+          move_tables.corner_permutation(corner_permutation, i);
+      const uint8_t next_corner_distance = getNeighbourDistance(
+          corner_distance,
+          pruning_tables.corner_slice_permutation
+              [next_slice_permutation * CornerPermutationCount +
+               next_corner_permutation]);
+      if (next_corner_distance >= remaining) continue;
+      const uint16_t next_edge_permutation =
+          move_tables.edge_permutation(edge_permutation, i);
+      const uint8_t next_edge_distance = getNeighbourDistance(
+          edge_distance, pruning_tables.edge_slice_permutation
+                             [next_slice_permutation * EdgePermutationCount +
+                              next_edge_permutation]);
+      if (next_edge_distance >= remaining) continue;
+
+      phase2_turns[depth] = i;
+      if (searchPhase2(next_corner_permutation, next_edge_permutation,
+                       next_slice_permutation, next_corner_distance,
+                       next_edge_distance, phase1_length, depth + 1,
+                       remaining - 1))
+        return true;
+    }
+    return false;
+  }
+
+  void recordSolve(const size_t& phase1_length, const size_t& phase2_length) {
+    best_solve.clear();
+    for (size_t i = 0; i < phase1_length; ++i)
+      best_solve.push_back(AllPossibleTurns[phase1_turns[i]]);
+    for (size_t i = 0; i < phase2_length; ++i)
+      best_solve.push_back(DominoReductionPreservingTurns[phase2_turns[i]]);
+    // convert the solve of the Direction's Cube to a solve of the Cube
+    if (direction->is_inverse) {
+      std::reverse(best_solve.begin(), best_solve.end());
+      for (Turn& turn : best_solve) turn = turn.inv();
+    }
+    const CubeOrientation inverse_orientation = direction->orientation.inv();
+    for (Turn& turn : best_solve) turn = inverse_orientation.apply(turn);
+    best_length = best_solve.size();
+    if (best_length <= max_length) is_done = true;
+  }
+};
+
+Algorithm solveTwoPhase(const Cube& cube, const size_t max_length,
+                        const std::chrono::steady_clock::duration timeout) {
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  TwoPhaseSearch search{CubieCube{cube}, max_length, deadline};
+
+  // the search works with the pieces in the identity CubeOrientation, so
+  // convert each Turn to the CubeOrientation of the Cube
+  const CubeOrientation inverse_orientation = cube.getOrientation().inv();
+  Algorithm solve;
+  for (const Turn& turn : search.search())
+    solve.push_back(Move{inverse_orientation.apply(turn)});
+  return solve;
+}
+
+// Test functions
+
+static void testMoveTables() {
+  static constexpr size_t Count = 1000;
+
+  const MoveTables& move_tables = getMoveTables();
+  for (size_t i = 0; i < Count; ++i) {
+    CubieCube cube{};
+    uint16_t flip = getFlip(cube);
+    uint16_t twist = getTwist(cube);
+    uint16_t slice = getSlice(cube);
+    uint32_t flip_slice = SolvedFlipSlice;
+    for (const Move& move : Algorithm::random(20)) {
+      const uint8_t turn_index =
+          TurnIndices<AllPossibleTurns>[getTurnTableIndex(move.getTurn())];
+      cube.apply(move.getTurn());
+      flip = move_tables.flip(flip, turn_index);
+      twist = move_tables.twist(twist, turn_index);
+      slice = move_tables.slice(slice, turn_index);
+      flip_slice = move_tables.flip_slice(flip_slice, turn_index);
+    }
+    if (flip != getFlip(cube) || twist != getTwist(cube) ||
+        slice != getSlice(cube))
+      throw std::logic_error("Phase 1 coordinate mismatch!");
+    if (flip_slice != slice * FlipCount + flip)
+      throw std::logic_error("Phase 1 product coordinate mismatch!");
+  }
+
+  for (size_t i = 0; i < Count; ++i) {
+    CubieCube cube{};
+    uint16_t corner_permutation = getCornerPermutation(cube);
+    uint16_t edge_permutation = getEdgePermutation(cube);
+    uint16_t slice_permutation = getSlicePermutation(cube);
+    uint32_t edge_slice_permutation = 0;
+    for (const Move& move :
+         Algorithm::random(20, DominoReductionPreservingTurns)) {
+      const uint8_t turn_index = TurnIndices<
+          DominoReductionPreservingTurns>[getTurnTableIndex(move.getTurn())];
+      cube.apply(move.getTurn());
+      edge_slice_permutation = move_tables.edge_slice_permutation(
+          edge_slice_permutation, turn_index);
+      corner_permutation =
+          move_tables.corner_permutation(corner_permutation, turn_index);
+      edge_permutation =
+          move_tables.edge_permutation(edge_permutation, turn_index);
+      slice_permutation =
+          move_tables.slice_permutation(slice_permutation, turn_index);
+    }
+    if (corner_permutation != getCornerPermutation(cube) ||
+        edge_permutation != getEdgePermutation(cube) ||
+        slice_permutation != getSlicePermutation(cube))
+      throw std::logic_error("Phase 2 coordinate mismatch!");
+    if (edge_slice_permutation !=
+        slice_permutation * EdgePermutationCount + edge_permutation)
+      throw std::logic_error("Phase 2 product coordinate mismatch!");
+  }
+}
+
+static void testSolvedCoordinates() {
+  const CubieCube cube{};
+  if (getFlip(cube) != 0 || getTwist(cube) != 0 ||
+      getSlice(cube) != SolvedSlice || getCornerPermutation(cube) != 0 ||
+      getEdgePermutation(cube) != 0 || getSlicePermutation(cube) != 0)
+    throw std::logic_error("Incorrect solved coordinates!");
+}
+
+static void testSearchDirections() {
+  static constexpr size_t Count = 100;
+
+  for (size_t i = 0; i < Count; ++i) {
+    const Algorithm alg = Algorithm::random(20);
+    const CubieCube cube{Cube{alg}};
+    if (getInverse(cube) != CubieCube{Cube{alg.inv()}})
+      throw std::logic_error("Inverse mismatch!");
+    for (const CubeOrientation& orientation : SearchOrientations) {
+      Algorithm conjugate_alg;
+      for (const Move& move : alg)
+        conjugate_alg.push_back(Move{orientation.apply(move.getTurn())});
+      if (getConjugate(cube, orientation) != CubieCube{Cube{conjugate_alg}})
+        throw std::logic_error("Conjugate mismatch!");
+    }
+  }
+}
+
+void runTwoPhaseSolverTests() {
+  testSolvedCoordinates();
+  testMoveTables();
+  testSearchDirections();
+}
+}  // namespace solvers
@@ -1,20 +1,29 @@
 #include "RunTests.h"
 #include "TestAlgorithm.h"
+#include "TestBatchReconstruction.h"
+#include "TestBestReconstructions.h"
 #include "TestBidirectionalStaticVector.h"
 #include "TestBlindsolvingMoveHash.h"
 #include "TestCombination.h"
+#include "TestCompactAlgorithm.h"
 #include "TestCornerCycleSequenceIterator.h"
 #include "TestCube.h"
+#include "TestCubeBatch.h"
 #include "TestCubeOrientation.h"
+#include "TestCubieCube.h"
 #include "TestDominoReductionSolver.h"
 #include "TestEdgeCycleSequenceIterator.h"
 #include "TestEdgeOrientationSolver.h"
 #include "TestHalfTurnReductionSolver.h"
+#include "TestLookupTableFile.h"
 #include "TestPLLs.h"
 #include "TestPackedBitsArray.h"
+#include "TestParseSolveAttempt.h"
 #include "TestPermutation.h"
 #include "TestReconstructionIterator.h"
 #include "TestThistlethwaiteSolver.h"
+#include "TestTrackedCube.h"
+#include "TestTwoPhaseSolver.h"
 #include <cstddef>
 #include <iostream>
 
@@ -23,17 +32,26 @@ void runTests() {
   testCombination();
   testPermutation();
   testPackedBitsArray();
+  testLookupTableFile();
   testAlgorithm();
+  testCompactAlgorithm();
   testCube();
+  testCubieCube();
+  testCubeBatch();
   testSolveCubeOrientation();
   testPLLs();
   testBlindsolvingMoveHash();
+  testParseSolveAttempt();
   testCornerCycleSequenceIterator();
   testEdgeCycleSequenceIterator();
+  testBestReconstructions();
+  testBatchReconstruction();
   testDominoReductionSolver();
   testEdgeOrientationSolver();
-  //  testHalfTurnReductionSolver();
-  //  testThistlethwaiteSolver();
+  testTwoPhaseSolver();
+  testHalfTurnReductionSolver();
+  testThistlethwaiteSolver();
+  testTrackedCube();
 
   static constexpr size_t Count = 10;
   for (size_t i = 0; i < Count; ++i) {
@@ -0,0 +1,85 @@
+#include "TestBatchReconstruction.h"
+#include "Algorithm.h"
+#include "BatchReconstruction.h"
+#include "Blindsolving.h"
+#include "Cube.h"
+#include "Reconstruction.h"
+#include "ReconstructionIterator.h"
+#include "SolveAttemptParsingUtils.h"
+#include <cstddef>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @return The attempt in file_name on a single line, without comments.
+ */
+static std::string loadAttemptLine(const std::string& file_name) {
+  const auto [scramble_str, solve_str] = utility::loadScrambleSolve(file_name);
+  std::string solve_line;
+  std::istringstream solve_stream{solve_str};
+  std::string line;
+  while (std::getline(solve_stream, line))
+    solve_line += line.substr(0, line.find("//")) + ' ';
+  return scramble_str.substr(0, scramble_str.find("//")) + '\t' + solve_line;
+}
+
+void testBatchReconstruction() {
+  using namespace blindsolving;
+  std::vector<std::string> attempts;
+  for (const char* file_name :
+       {"tests/blindsolve1.txt", "tests/blindsolve3.txt"})
+    attempts.push_back(loadAttemptLine(file_name));
+  attempts.emplace_back("missing separator");
+  std::vector<std::string> expected_distances;
+  for (const std::string& attempt : attempts) {
+    std::istringstream attempt_stream{attempt};
+    try {
+      const auto [scramble_str, solve_str] =
+          *utility::readScrambleSolve(attempt_stream);
+      ReconstructionIterator it =
+          getReconstructionIterator(Cube{Algorithm::parse(scramble_str)});
+      expected_distances.push_back(std::to_string(
+          searchBestReconstructions(
+              parseSolveAttempt(Algorithm::parseExpanded(solve_str)), it, 1)
+              .front()
+              .second));
+    } catch (const std::invalid_argument&) {
+      expected_distances.emplace_back("error");
+    }
+  }
+
+  static constexpr size_t Repetitions = 10;
+  std::string input;
+  for (size_t i = 0; i < Repetitions; ++i)
+    for (const std::string& attempt : attempts) input += attempt + "\n\n";
+
+  for (const auto& [thread_count, max_pending] :
+       std::vector<std::pair<size_t, size_t>>{{1, 1}, {3, 2}, {4, 100}}) {
+    std::istringstream input_stream{input};
+    std::ostringstream output_stream;
+    const BatchStatistics statistics = reconstructBatch(
+        input_stream, output_stream, thread_count, max_pending);
+    if (statistics.attempt_count != Repetitions * attempts.size() ||
+        statistics.failure_count != Repetitions)
+      throw std::logic_error("Incorrect batch statistics!");
+
+    std::istringstream output{output_stream.str()};
+    std::string line;
+    size_t index = 0;
+    while (std::getline(output, line)) {
+      const std::string prefix = std::to_string(index) + '\t' +
+                                 expected_distances[index % attempts.size()] +
+                                 '\t';
+      if (line.rfind(prefix, 0) != 0)
+        throw std::logic_error("Incorrect batch reconstruction output!");
+      ++index;
+    }
+    if (index != statistics.attempt_count)
+      throw std::logic_error("Incorrect number of batch output lines!");
+  }
+  std::cout << "Passed all tests for reconstructBatch!\n";
+}
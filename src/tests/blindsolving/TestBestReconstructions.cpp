@@ -0,0 +1,146 @@
+#include "TestBestReconstructions.h"
+#include "Algorithm.h"
+#include "Blindsolving.h"
+#include "BlindsolvingReconstruction.h"
+#include "BlindsolvingMove.h"
+#include "Cube.h"
+#include "RandomUtils.h"
+#include "Reconstruction.h"
+#include "ReconstructionIterator.h"
+#include "SolveAttemptParsingUtils.h"
+#include "Utils.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+static void testLevEditDistance() {
+  const std::vector<char> kitten{'k', 'i', 't', 't', 'e', 'n'};
+  const std::vector<char> sitting{'s', 'i', 't', 't', 'i', 'n', 'g'};
+  if (utility::levEditDistance(kitten, sitting) != 3 ||
+      utility::levEditDistance(std::vector<char>{'a'},
+                               std::vector<char>{'b'}) != 1 ||
+      utility::levEditDistance(std::vector<char>{'a', 'b'},
+                               std::vector<char>{}) != 2)
+    throw std::logic_error("Incorrect edit distance!");
+}
+
+static constexpr uint8_t encodeLowercase(const char& chr) { return chr - 'a'; }
+
+/**
+ * Compares utility::BitParallelEditDistance against levEditDistance, both for
+ * strings and for random reconstructions of random scrambles.
+ */
+static void testBitParallelEditDistance() {
+  using namespace blindsolving;
+  using StringEditDistance =
+      utility::BitParallelEditDistance<char, 26, encodeLowercase>;
+  const std::vector<char> kitten{'k', 'i', 't', 't', 'e', 'n'};
+  const std::vector<char> sitting{'s', 'i', 't', 't', 'i', 'n', 'g'};
+  if (StringEditDistance{kitten}(sitting) != 3 ||
+      StringEditDistance{std::vector<char>{}}(std::vector<char>{'a'}) != 1 ||
+      StringEditDistance{std::vector<char>{'a', 'b'}}(std::vector<char>{}) !=
+          2)
+    throw std::logic_error("Incorrect bit-parallel edit distance!");
+
+  using ReconstructionEditDistance =
+      utility::BitParallelEditDistance<BlindsolvingMove,
+                                       BlindsolvingMoveAlphabetSize, encode>;
+  static constexpr size_t Count = 100;
+  for (size_t i = 0; i < Count; ++i) {
+    ReconstructionIterator it =
+        getReconstructionIterator(Cube{Algorithm::random(20)});
+    BlindsolvingReconstruction pattern = *it;
+    // pad the pattern to the maximum length at least once
+    if (i == 0)
+      while (pattern.size() <
+             ReconstructionEditDistance::MaxPatternLength)
+        pattern.push_back(BlindsolvingMove{true, ' '});
+    const ReconstructionEditDistance edit_distance{pattern};
+    do {
+      const BlindsolvingReconstruction text = *it;
+      if (edit_distance(text) != utility::levEditDistance(pattern, text))
+        throw std::logic_error("Incorrect bit-parallel edit distance!");
+    } while (++it && it.rank() < 100);
+  }
+}
+
+/**
+ * Compares searchBestReconstructions against getBestReconstructions for a
+ * solve attempt that differs from one of the reconstructions of a random
+ * scramble in a few BlindsolvingMoves.
+ */
+static void testSearchBestReconstructions() {
+  using namespace blindsolving;
+  static constexpr size_t Count = 10;
+  for (size_t i = 0; i < Count; ++i) {
+    ReconstructionIterator it = getReconstructionIterator(Cube{
+        Algorithm::random(20)});
+    it.seek(std::uniform_int_distribution<size_t>{
+        0, it.getPeriod() - 1}(utility::random_engine));
+    const BlindsolvingReconstruction attempt = *it;
+    Reconstruction reconstruction;
+    for (const BlindsolvingMove& move : attempt) {
+      if (move.is_parity)
+        reconstruction.emplace_back();
+      else
+        reconstruction.emplace_back(Algorithm{}, move.is_edge, move.alg);
+    }
+    for (size_t j = 0; j < 3 && !reconstruction.empty(); ++j)
+      reconstruction.erase(
+          reconstruction.begin() +
+          std::uniform_int_distribution<size_t>{
+              0, reconstruction.size() - 1}(utility::random_engine));
+    reconstruction.emplace_back(Algorithm{});
+
+    for (const size_t& max : {size_t{1}, size_t{5}}) {
+      if (searchBestReconstructions(reconstruction, it, max) !=
+          getBestReconstructions(reconstruction, it, max))
+        throw std::logic_error("Searched best reconstructions differ!");
+    }
+  }
+}
+
+void testBestReconstructions() {
+  using namespace blindsolving;
+  testLevEditDistance();
+  testBitParallelEditDistance();
+  for (const char* const file_name :
+       {"tests/blindsolve1.txt", "tests/blindsolve3.txt"}) {
+    const auto [scramble_str, solve_str] =
+        utility::loadScrambleSolve(file_name);
+    const Reconstruction reconstruction =
+        parseSolveAttempt(Algorithm::parseExpanded(solve_str));
+    ReconstructionIterator it =
+        getReconstructionIterator(Cube{Algorithm::parse(scramble_str)});
+
+    for (const size_t& max : {size_t{1}, size_t{5}, it.getPeriod() + 1}) {
+      const std::vector<std::pair<BlindsolvingReconstruction, size_t>>
+          best_reconstructions =
+              getBestReconstructions(reconstruction, it, max);
+      if (best_reconstructions.size() != std::min(max, it.getPeriod()))
+        throw std::logic_error("Incorrect number of best reconstructions!");
+      for (size_t i = 1; i < best_reconstructions.size(); ++i)
+        if (best_reconstructions[i - 1].second >
+            best_reconstructions[i].second)
+          throw std::logic_error("Best reconstructions are not sorted!");
+
+      if (searchBestReconstructions(reconstruction, it, max) !=
+          best_reconstructions)
+        throw std::logic_error("Searched best reconstructions differ!");
+      for (const size_t thread_count : {size_t{1}, size_t{2}, size_t{5}}) {
+        if (getBestReconstructionsParallel(reconstruction, it, max,
+                                           thread_count) !=
+            best_reconstructions)
+          throw std::logic_error("Parallel best reconstructions differ!");
+      }
+    }
+  }
+  testSearchBestReconstructions();
+  std::cout << "Passed all tests for getBestReconstructions!\n";
+}
@@ -4,6 +4,7 @@
 #include "CornerRotationAmount.h"
 #include "Cube.h"
 #include "Utils.h"
+#include <cstddef>
 #include <iostream>
 #include <stdexcept>
 #include <vector>
@@ -26,8 +27,16 @@ void testCornerCycleSequenceIterator() {
       CornerRotationAmount::Counterclockwise};
   blindsolving::CornerCycleSequenceIterator it{cycles, rotation_amounts};
   const Cube cube = applyCornerAlgs(*it);
-  while (++it)
+  blindsolving::CornerCycleSequenceIterator seek_it = it;
+  size_t index = 0;
+  do {
     if (cube != applyCornerAlgs(*it)) throw std::logic_error("Mismatch!");
+    if (it.rank() != index) throw std::logic_error("Incorrect rank!");
+    seek_it.seek(index++);
+    if (*seek_it != *it) throw std::logic_error("Incorrect seek!");
+  } while (++it);
+  if (index != it.getPeriod())
+    throw std::logic_error("Incorrect period!");
 
   std::cout << "Passed all tests for CornerCycleSequenceIterator!\n";
 }
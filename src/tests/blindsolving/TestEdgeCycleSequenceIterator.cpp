@@ -3,6 +3,7 @@
 #include "Cube.h"
 #include "EdgeCycleSequenceIterator.h"
 #include "Utils.h"
+#include <cstddef>
 #include <iostream>
 #include <stdexcept>
 #include <vector>
@@ -23,8 +24,16 @@ void testEdgeCycleSequenceIterator() {
   std::vector<bool> are_even{false, true, false};
   blindsolving::EdgeCycleSequenceIterator it{cycles, are_even};
   const Cube cube = applyEdgeAlgs(*it);
-  while (++it)
+  blindsolving::EdgeCycleSequenceIterator seek_it = it;
+  size_t index = 0;
+  do {
     if (cube != applyEdgeAlgs(*it)) throw std::logic_error("Mismatch!");
+    if (it.rank() != index) throw std::logic_error("Incorrect rank!");
+    seek_it.seek(index++);
+    if (*seek_it != *it) throw std::logic_error("Incorrect seek!");
+  } while (++it);
+  if (index != it.getPeriod())
+    throw std::logic_error("Incorrect period!");
 
   std::cout << "Passed all tests for EdgeCycleSequenceIterator!\n";
 }
@@ -0,0 +1,92 @@
+#include "TestParseSolveAttempt.h"
+#include "Algorithm.h"
+#include "Blindsolving.h"
+#include "BlindsolvingMove.h"
+#include "Cube.h"
+#include "Move.h"
+#include "RotationAmount.h"
+#include "RandomUtils.h"
+#include "Reconstruction.h"
+#include "SolveData.h"
+#include "Turn.h"
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/**
+ * Appends move to alg the way a solver would, merging it into the last move of
+ * alg if both turn the same face.
+ * @return Whether the two moves were merged.
+ */
+static bool appendWithCancellation(Algorithm& alg, const Move& move) {
+  if (alg.empty() || !alg.back().isTurn() || !move.isTurn() ||
+      alg.back().getTurn().face != move.getTurn().face) {
+    alg.push_back(move);
+    return false;
+  }
+  Turn& turn = alg.back().getTurn();
+  turn.rotation_amount += move.getTurn().rotation_amount;
+  if (turn.rotation_amount == RotationAmount::None) alg.pop_back();
+  return true;
+}
+
+/**
+ * Parses random sequences of algs whose boundary turns are merged, as when a
+ * solver cancels the end of one alg into the start of the next.
+ */
+void testParseSolveAttempt() {
+  using namespace blindsolving;
+  runBlindsolvingTests();
+
+  std::vector<std::pair<BlindsolvingMove, Algorithm>> algs;
+  // parsing matches the shortest prefix with the right effect, so the algs
+  // are simplified first to keep the expected parse unambiguous
+  const auto add = [&](const BlindsolvingMove& blindsolving_move,
+                       const Algorithm& alg) {
+    Algorithm simplified;
+    for (const Move& move : alg) appendWithCancellation(simplified, move);
+    algs.emplace_back(blindsolving_move, simplified);
+  };
+  for (const auto& [chr, alg] : EDGE_ALGS)
+    // O starts with M2, which parsing greedily reads as A
+    if (chr != 'O') add(BlindsolvingMove{true, chr}, alg);
+  for (const auto& [chr, alg] : CORNER_ALGS)
+    add(BlindsolvingMove{false, chr}, alg);
+  add(BlindsolvingMove{}, PARITY_ALG);
+
+  static constexpr size_t Count = 200;
+  static constexpr size_t AlgCount = 8;
+  std::uniform_int_distribution<size_t> distribution{0, algs.size() - 1};
+  size_t cancellation_count = 0;
+  for (size_t i = 0; i < Count; ++i) {
+    Algorithm attempt;
+    std::vector<BlindsolvingMove> expected;
+    for (size_t j = 0; j < AlgCount; ++j) {
+      const auto& [blindsolving_move, alg] =
+          algs[distribution(utility::random_engine)];
+      if (appendWithCancellation(attempt, alg.front())) ++cancellation_count;
+      attempt.insert(attempt.end(), alg.begin() + 1, alg.end());
+      expected.push_back(blindsolving_move);
+    }
+
+    const Reconstruction reconstruction = parseSolveAttempt(attempt);
+    if (reconstruction.size() != expected.size())
+      throw std::logic_error("Incorrect number of parsed algs!");
+    Cube parsed_cube{};
+    for (size_t j = 0; j < expected.size(); ++j) {
+      if (!reconstruction[j].is_parsed ||
+          reconstruction[j].blindsolving_move != expected[j])
+        throw std::logic_error("Incorrectly parsed alg!");
+      parsed_cube.apply(reconstruction[j].moves);
+    }
+    if (parsed_cube != Cube{attempt})
+      throw std::logic_error("Parsed moves differ from the attempt!");
+  }
+  if (cancellation_count == 0)
+    throw std::logic_error("No cancellations were tested!");
+  std::cout << "Passed all tests for parseSolveAttempt (" << cancellation_count
+            << " cancellations)!\n";
+}
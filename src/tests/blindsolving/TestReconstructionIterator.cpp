@@ -3,6 +3,7 @@
 #include "Blindsolving.h"
 #include "Cube.h"
 #include "ReconstructionIterator.h"
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 #include <unordered_set>
@@ -12,11 +13,19 @@ void testReconstructionIterator(const Cube& scrambled_cube) {
       blindsolving::getReconstructionIterator(scrambled_cube);
   std::unordered_set<blindsolving::BlindsolvingReconstruction> recons{};
   std::cout << "Testing " << it.getPeriod() << " reconstructions...\n";
-  size_t i = 0;  // only used if info == true
+  blindsolving::ReconstructionIterator seek_it = it;
+  blindsolving::ReconstructionIterator::Buffer buffer;
+  size_t i = 0;
   do {
     const blindsolving::BlindsolvingReconstruction recon = *it;
     if (!recons.insert(recon).second)
       throw std::logic_error("Duplicate reconstruction!");
+    if (it.rank() != i) throw std::logic_error("Incorrect rank!");
+    seek_it.seek(i);
+    if (*seek_it != recon) throw std::logic_error("Incorrect seek!");
+    it.writeTo(buffer);
+    if (!std::equal(buffer.begin(), buffer.end(), recon.begin(), recon.end()))
+      throw std::logic_error("writeTo differs from operator*!");
     Cube cube = scrambled_cube;
     recon.applyTo(cube);
     if (!cube.isSolved())
@@ -4,8 +4,33 @@
 #include "SolveAttemptParsingUtils.h"
 #include <iostream>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+
+/**
+ * Parses from views into a larger buffer, which is how memory mapped files
+ * are parsed without copying.
+ */
+static void testParseStringView() {
+  const std::string buffer = "R U R' U' // comment\nF2 M' x|D";
+  const std::string_view alg{buffer.data(), buffer.find('|')};
+  if (Algorithm::parse(alg) != Algorithm::parse("R U R' U' F2 M' x") ||
+      Algorithm::parseExpanded(alg) !=
+          Algorithm::parseExpanded("R U R' U' F2 M' x"))
+    throw std::logic_error("Incorrectly parsed string_view!");
+  if (!Algorithm::parse(alg.substr(0, 0)).empty())
+    throw std::logic_error("Parsed moves from an empty string_view!");
+}
+
+static void testParseExpanded() {
+  if (Algorithm::parseExpanded("R2 U3' Rw2 M x") !=
+      Algorithm::parse("R R U' U' U' Rw Rw M x"))
+    throw std::logic_error("Incorrectly expanded moves!");
+}
 
 void testAlgorithm() {
+  testParseStringView();
+  testParseExpanded();
   for (const std::string file_name :
        {"tests/blindsolve1.txt", "tests/blindsolve2.txt",
         "tests/blindsolve3.txt"}) {
@@ -0,0 +1,57 @@
+#include "TestCompactAlgorithm.h"
+#include "Algorithm.h"
+#include "CompactAlgorithm.h"
+#include "CompactMove.h"
+#include "Cube.h"
+#include "Move.h"
+#include "Turn.h"
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+
+static void testConversion() {
+  const Algorithm alg =
+      Algorithm::parse("R U2 M' r x' E2 S f' y2 D L2 z b' B E' u2 d l F'");
+  const CompactAlgorithm compact_alg{alg};
+  if (compact_alg.size() != alg.size() ||
+      compact_alg.toAlgorithm().toStr() != alg.toStr())
+    throw std::logic_error("CompactAlgorithm conversion is not lossless!");
+  for (const Move& move : alg)
+    if (CompactMove{CompactMove{move}.toMove()} != CompactMove{move})
+      throw std::logic_error("CompactMove conversion is not lossless!");
+
+  Cube cube{};
+  cube.apply(compact_alg);
+  if (cube != Cube{alg})
+    throw std::logic_error("CompactAlgorithm applied incorrectly!");
+  cube.apply(compact_alg.inv());
+  if (cube != Cube{})
+    throw std::logic_error("CompactAlgorithm inverted incorrectly!");
+}
+
+static void testCancelMoves() {
+  static constexpr size_t Count = 1000;
+  static constexpr size_t Length = 40;
+  for (size_t i = 0; i < Count; ++i) {
+    // Algorithm::random already cancels its moves, so build one manually
+    Algorithm alg;
+    for (size_t j = 0; j < Length; ++j) alg.push_back(Move{Turn::random()});
+    CompactAlgorithm compact_alg{alg};
+    compact_alg.cancelMoves();
+    Cube cube{};
+    cube.apply(compact_alg);
+    if (cube != Cube{alg})
+      throw std::logic_error("CompactAlgorithm::cancelMoves changed the alg!");
+
+    // both only merge adjacent moves when the Algorithm consists of Turns
+    alg.cancelMoves();
+    if (compact_alg.toAlgorithm().toStr() != alg.toStr())
+      throw std::logic_error("CompactAlgorithm::cancelMoves differs!");
+  }
+}
+
+void testCompactAlgorithm() {
+  testConversion();
+  testCancelMoves();
+  std::cout << "Passed all tests for CompactAlgorithm!\n";
+}
@@ -0,0 +1,43 @@
+#include "TestCubeBatch.h"
+#include "Algorithm.h"
+#include "Cube.h"
+#include "CubeBatch.h"
+#include "CubieCube.h"
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+void testCubeBatch() {
+  static constexpr size_t Count = 100;
+  const Algorithm scramble = Algorithm::random(20);
+  // include every kind of Move so that the CubeOrientation is tracked as well
+  const Algorithm alg = Algorithm::parse("M2 U R' x y2 Rw F' S E2 z' D Lw'");
+
+  std::vector<Cube> cubes;
+  for (size_t i = 0; i < Count; ++i)
+    cubes.push_back(i % 3 == 0 ? Cube{scramble} : Cube{Algorithm::random(20)});
+  CubeBatch batch{cubes};
+
+  batch.apply(alg);
+  for (size_t i = 0; i < Count; ++i) {
+    cubes[i].apply(alg);
+    if (batch[i] != CubieCube{cubes[i]})
+      throw std::logic_error("CubeBatch does not match the individual Cubes!");
+  }
+
+  batch.apply(alg.inv() + scramble.inv());
+  const std::vector<bool> is_solved = batch.isSolved();
+  for (size_t i = 0; i < Count; ++i) {
+    cubes[i].apply(alg.inv() + scramble.inv());
+    if (is_solved[i] != cubes[i].isSolved())
+      throw std::logic_error("CubeBatch::isSolved is incorrect!");
+    if (i % 3 == 0 && !is_solved[i])
+      throw std::logic_error("Cube was not solved by the inverse scramble!");
+  }
+
+  const std::vector<bool> solved_batch = CubeBatch{Count}.isSolved();
+  for (const bool& solved : solved_batch)
+    if (!solved) throw std::logic_error("Cube is not solved initially!");
+  std::cout << "Passed all tests for CubeBatch!\n";
+}
@@ -0,0 +1,81 @@
+#include "TestCubieCube.h"
+#include "Algorithm.h"
+#include "CornerLocation.h"
+#include "Cube.h"
+#include "CubieCube.h"
+#include "EdgeLocation.h"
+#include "Move.h"
+#include "RotationAmount.h"
+#include "Turn.h"
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+
+/**
+ * Applies the given Turn by cycling the pieces through their locations, which
+ * is how Cube::apply used to be implemented before it used TurnTables.
+ */
+static void applyByCycling(Cube& cube, const Turn& turn) {
+  const std::array<EdgeLocation, 4> edges =
+      detail::getEdgeLocationCycle(turn.face);
+  const std::array<CornerLocation, 4> corners =
+      detail::getCornerLocationCycle(turn.face);
+  switch (turn.rotation_amount) {
+    case RotationAmount::None:
+      break;
+    case RotationAmount::Clockwise:
+      cube.cycleEdges<4>(edges);
+      cube.cycleCorners<4>(corners);
+      break;
+    case RotationAmount::HalfTurn:
+      cube.cycleEdges<2>({edges[0], edges[2]});
+      cube.cycleEdges<2>({edges[1], edges[3]});
+      cube.cycleCorners<2>({corners[0], corners[2]});
+      cube.cycleCorners<2>({corners[1], corners[3]});
+      break;
+    case RotationAmount::Counterclockwise:
+      cube.cycleEdges<4>({edges[3], edges[2], edges[1], edges[0]});
+      cube.cycleCorners<4>({corners[3], corners[2], corners[1], corners[0]});
+      break;
+    default:
+      throw std::logic_error("Unknown enum value!");
+  }
+}
+
+void testCubieCube() {
+  static constexpr size_t Count = 1000;
+  for (size_t i = 0; i < Count; ++i) {
+    const Algorithm alg = Algorithm::random(20);
+    Cube cube{};
+    Cube cycled_cube{};
+    CubieCube cubie_cube{};
+    CubieCube scalar_cubie_cube{};
+    for (const Move& move : alg) {
+      cube.apply(move.getTurn());
+      applyByCycling(cycled_cube, move.getTurn());
+      cubie_cube.apply(move.getTurn());
+      scalar_cubie_cube.applyScalar(move.getTurn());
+    }
+
+    if (cube != cycled_cube)
+      throw std::logic_error("TurnTables do not match cycling the pieces!");
+    if (scalar_cubie_cube != cubie_cube)
+      throw std::logic_error("Vectorized and scalar Turns do not match!");
+    if (CubieCube{cube} != cubie_cube)
+      throw std::logic_error("CubieCube does not match Cube!");
+    if (cubie_cube.toCube() != cube)
+      throw std::logic_error("CubieCube did not convert back to the Cube!");
+
+    CubieCube inverted_cube = cubie_cube;
+    for (const Move& move : alg.inv()) inverted_cube.apply(move.getTurn());
+    if (!inverted_cube.isSolved())
+      throw std::logic_error("CubieCube was not solved by the inverse!");
+  }
+
+  Cube scrambled_cube{};
+  scrambled_cube.scramble();
+  if (CubieCube{scrambled_cube}.toCube() != scrambled_cube)
+    throw std::logic_error("CubieCube did not convert back to the Cube!");
+  std::cout << "Passed all tests for CubieCube!\n";
+}
@@ -1,7 +1,12 @@
 #include "TestThistlethwaiteSolver.h"
 #include "Algorithm.h"
 #include "Cube.h"
+#include "DominoReductionSolver.h"
+#include "EdgeOrientationSolver.h"
+#include "HalfTurnReductionSolver.h"
 #include "ThistlethwaiteSolver.h"
+#include <array>
+#include <cstddef>
 #include <iostream>
 #include <stdexcept>
 
@@ -14,14 +19,39 @@ static void testSolveThistlethwaite() {
     Cube cube{};
     cube.scramble();
     const Algorithm solve = solveThistlethwaite(cube);
+    if (solve.size() > 45) throw std::logic_error("Solve was too long!");
     cube.apply(solve);
     if (!cube.isSolved()) throw std::logic_error("Cube was not solved!");
   }
 }
 
+static void testSolveThistlethwaiteStages() {
+  static constexpr std::array<size_t, 4> MaxStageLengths{7, 10, 13, 15};
+  static constexpr std::array<bool (*)(const Cube&), 4> IsStageSolved{
+      areEdgesOriented, isDominoReduced, isHalfTurnReduced,
+      [](const Cube& cube) { return cube.isSolved(); }};
+  static constexpr size_t Count = 100;
+
+  for (size_t i = 0; i < Count; ++i) {
+    Cube cube{};
+    cube.scramble();
+    const ThistlethwaiteSolve solve = solveThistlethwaiteStages(cube);
+    if (solve.getAlgorithm() != solveThistlethwaite(cube))
+      throw std::logic_error("Stages do not match the solve!");
+    for (size_t j = 0; j < solve.stages.size(); ++j) {
+      if (solve.stages[j].solve.size() > MaxStageLengths[j])
+        throw std::logic_error("Stage was too long!");
+      cube.apply(solve.stages[j].solve);
+      if (!IsStageSolved[j](cube))
+        throw std::logic_error("Stage was not solved!");
+    }
+  }
+}
+
 void testThistlethwaiteSolver() {
   runThistlethwaiteSolverTests();
   testSolveThistlethwaite();
+  testSolveThistlethwaiteStages();
 
   std::cout << "Passed all tests for ThistlethwaiteSolver!\n";
 }
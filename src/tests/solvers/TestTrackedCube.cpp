@@ -0,0 +1,98 @@
+#include "TestTrackedCube.h"
+#include "Algorithm.h"
+#include "Cube.h"
+#include "DominoReductionSolver.h"
+#include "EdgeOrientationSolver.h"
+#include "HalfTurnReductionSolver.h"
+#include "Move.h"
+#include "RandomUtils.h"
+#include "TrackedCube.h"
+#include "TurnSets.h"
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+
+using namespace solvers;
+
+static void checkDescriptors(const TrackedCube& tracked_cube) {
+  const Cube& cube = tracked_cube.getCube();
+  if (tracked_cube.getEdgeOrientationDescriptor() !=
+          getEdgeOrientationDescriptor(cube) ||
+      tracked_cube.getDominoReductionDescriptor() !=
+          getDominoReductionDescriptor(cube))
+    throw std::logic_error("Tracked descriptor mismatch!");
+  if (areEdgesOriented(tracked_cube) != areEdgesOriented(cube) ||
+      isDominoReduced(tracked_cube) != isDominoReduced(cube) ||
+      isHalfTurnReduced(tracked_cube) != isHalfTurnReduced(cube))
+    throw std::logic_error("Tracked subgroup mismatch!");
+  if (isDominoReduced(cube) && tracked_cube.getHalfTurnReductionDescriptor() !=
+                                   getHalfTurnReductionDescriptor(cube))
+    throw std::logic_error("Tracked descriptor mismatch!");
+}
+
+static void testApplyMoves() {
+  // includes slice turns, wide turns and rotations, which change the faces
+  // that later Turns are applied to
+  static const std::array<Algorithm, 8> Moves{
+      Algorithm::parse("M"),  Algorithm::parse("E'"), Algorithm::parse("S2"),
+      Algorithm::parse("r"),  Algorithm::parse("u2"), Algorithm::parse("x"),
+      Algorithm::parse("y'"), Algorithm::parse("z2")};
+  static constexpr size_t Count = 1000;
+
+  TrackedCube tracked_cube{};
+  checkDescriptors(tracked_cube);
+  for (size_t i = 0; i < Count; ++i) {
+    if (utility::randomInt<3>() == 0)
+      tracked_cube.apply(utility::pickRandom(Moves));
+    else
+      tracked_cube.apply(utility::pickRandom(AllPossibleTurns));
+    checkDescriptors(tracked_cube);
+  }
+}
+
+static void testHalfTurnReductionDescriptor() {
+  static constexpr size_t Count = 100;
+  static constexpr size_t Length = 20;
+
+  for (size_t i = 0; i < Count; ++i) {
+    Cube cube{};
+    cube.scramble();
+    TrackedCube tracked_cube{cube};
+    checkDescriptors(tracked_cube);
+    // entering domino reduction recomputes the descriptor, after which it is
+    // updated incrementally
+    tracked_cube.apply(solveDominoReduction(tracked_cube));
+    checkDescriptors(tracked_cube);
+    for (size_t j = 0; j < Length; ++j) {
+      tracked_cube.apply(utility::pickRandom(DominoReductionPreservingTurns));
+      checkDescriptors(tracked_cube);
+    }
+    tracked_cube.apply(solveHalfTurnReduction(tracked_cube));
+    if (!isHalfTurnReduced(tracked_cube))
+      throw std::logic_error("Cube was not half turn reduced!");
+    checkDescriptors(tracked_cube);
+  }
+}
+
+static void testSolve() {
+  static constexpr size_t Count = 100;
+
+  for (size_t i = 0; i < Count; ++i) {
+    Cube cube{};
+    cube.scramble();
+    const TrackedCube tracked_cube{cube};
+    if (solveEdgeOrientation(tracked_cube) != solveEdgeOrientation(cube) ||
+        solveDominoReduction(tracked_cube) != solveDominoReduction(cube) ||
+        solveHalfTurnReduction(tracked_cube) != solveHalfTurnReduction(cube))
+      throw std::logic_error("Tracked solve mismatch!");
+  }
+}
+
+void testTrackedCube() {
+  testApplyMoves();
+  testHalfTurnReductionDescriptor();
+  testSolve();
+
+  std::cout << "Passed all tests for TrackedCube!\n";
+}
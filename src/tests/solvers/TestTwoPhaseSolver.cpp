@@ -0,0 +1,59 @@
+#include "TestTwoPhaseSolver.h"
+#include "Algorithm.h"
+#include "Cube.h"
+#include "CubieCube.h"
+#include "TwoPhaseSolver.h"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using namespace solvers;
+
+static void testSolveTwoPhase() {
+  static constexpr size_t Count = 100;
+
+  size_t total_length = 0;
+  for (size_t i = 0; i < Count; ++i) {
+    static const std::array<std::string, 4> Rotations = {"", "x", "y2 z",
+                                                         "x' y"};
+    Cube cube{Algorithm::parse(Rotations[i % Rotations.size()])};
+    cube.scramble();
+    const Algorithm solve = solveTwoPhase(cube);
+    cube.apply(solve);
+    if (!CubieCube{cube}.isSolved())
+      throw std::logic_error("Two-phase solve did not solve the cube!");
+    total_length += solve.size();
+  }
+  std::cout << "Average two-phase solve length: "
+            << static_cast<double>(total_length) / Count << '\n';
+}
+
+static void testShortScrambles() {
+  static constexpr size_t Count = 20;
+  static constexpr size_t MaxScrambleLength = 6;
+
+  for (size_t i = 0; i < Count; ++i) {
+    const Algorithm scramble = Algorithm::random(i % MaxScrambleLength + 1);
+    Cube cube{scramble};
+    // with no length budget, the search only stops once no shorter solve is
+    // possible, which happens well before the timeout for short scrambles
+    const Algorithm solve = solveTwoPhase(cube, 0, std::chrono::seconds{60});
+    cube.apply(solve);
+    if (!cube.isSolved())
+      throw std::logic_error("Two-phase solve did not solve the cube!");
+    if (solve.size() > scramble.size())
+      throw std::logic_error("Two-phase solve is longer than the scramble!");
+  }
+}
+
+void testTwoPhaseSolver() {
+  std::cout << "Generating two-phase solver tables...\n";
+  runTwoPhaseSolverTests();
+  testSolveTwoPhase();
+  testShortScrambles();
+
+  std::cout << "Passed all tests for TwoPhaseSolver!\n";
+}
@@ -0,0 +1,120 @@
+#include "TestLookupTableFile.h"
+#include "LookupTableFile.h"
+#include "PackedBitsArray.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using utility::MappedLookupTable;
+using utility::PackedBitsArray;
+using utility::PackedBitsArrayView;
+
+static constexpr uint8_t Bits = 25;
+static constexpr size_t Count = 800;
+static constexpr uint64_t TableId = 0x0123456789abcdef;
+static const std::string FileName =  // NOLINT(cert-err58-cpp)
+    "./lookup_tables/TestLookupTable.bin";
+
+static PackedBitsArray<Bits, Count> getTestArray() {
+  static constexpr uint32_t multiplier = (1 << 13) + (1 << 8) + 1;
+  PackedBitsArray<Bits, Count> arr;
+  for (size_t i = 0; i < arr.size(); ++i) arr[i] = multiplier * i;
+  return arr;
+}
+
+static void writeTestArray() {
+  const PackedBitsArray<Bits, Count> arr = getTestArray();
+  utility::writeLookupTableFile(FileName, Bits, Count, TableId,
+                                arr.rawData().data(), arr.rawData().size());
+}
+
+static void testRoundTrip() {
+  writeTestArray();
+  const std::optional<MappedLookupTable> table =
+      MappedLookupTable::open(FileName, Bits, Count, TableId);
+  if (!table) throw std::logic_error("Lookup table file was not found!");
+
+  const PackedBitsArray<Bits, Count> arr = getTestArray();
+  const PackedBitsArrayView<Bits, Count> view{table->data()};
+  if (table->size() != arr.rawData().size())
+    throw std::logic_error("Lookup table file has the wrong size!");
+  for (size_t i = 0; i < arr.size(); ++i)
+    if (view[i] != arr[i])
+      throw std::logic_error("PackedBitsArrayView failed!");
+}
+
+static void testMissingFile() {
+  if (MappedLookupTable::open("./lookup_tables/DoesNotExist.bin", Bits, Count,
+                              TableId))
+    throw std::logic_error("Mapped a lookup table file that does not exist!");
+}
+
+/**
+ * Writers of the same table each use their own temporary file, so the table
+ * that they leave behind is always complete and no temporary files remain.
+ */
+static void testConcurrentWrites() {
+  std::vector<std::thread> writers;
+  for (size_t i = 0; i < 4; ++i) writers.emplace_back(writeTestArray);
+  for (std::thread& writer : writers) writer.join();
+  if (!MappedLookupTable::open(FileName, Bits, Count, TableId))
+    throw std::logic_error("Lookup table file was not found!");
+
+  const std::filesystem::path path{FileName};
+  for (const auto& entry :
+       std::filesystem::directory_iterator{path.parent_path()})
+    if (entry.path().filename().string().starts_with(
+            path.filename().string() + '.'))
+      throw std::logic_error("A temporary lookup table file remains!");
+}
+
+static void expectInvalid(const uint8_t& bits, const size_t& count,
+                          const uint64_t& table_id = TableId) {
+  try {
+    MappedLookupTable::open(FileName, bits, count, table_id);
+  } catch (const std::runtime_error&) {
+    return;
+  }
+  throw std::logic_error("Mapped an invalid lookup table file!");
+}
+
+static void testInvalidFiles() {
+  writeTestArray();
+  expectInvalid(Bits + 1, Count);
+  expectInvalid(Bits, Count + 1);
+  // a table of the same shape generated for something else
+  expectInvalid(Bits, Count, TableId + 1);
+
+  // flip a bit in the payload to break the checksum
+  {
+    std::fstream file{FileName,
+                      std::ios::binary | std::ios::in | std::ios::out};
+    file.seekg(sizeof(utility::LookupTableHeader) + 10);
+    const char byte = static_cast<char>(file.get() ^ 1);
+    file.seekp(sizeof(utility::LookupTableHeader) + 10);
+    file.put(byte);
+  }
+  expectInvalid(Bits, Count);
+
+  // truncate the payload
+  std::filesystem::resize_file(FileName, sizeof(utility::LookupTableHeader));
+  expectInvalid(Bits, Count);
+
+  std::filesystem::remove(FileName);
+}
+
+void testLookupTableFile() {
+  testRoundTrip();
+  testMissingFile();
+  testConcurrentWrites();
+  testInvalidFiles();
+
+  std::cout << "Passed all tests for LookupTableFile!\n";
+}
@@ -1,8 +1,58 @@
 #include "TestPackedBitsArray.h"
 #include "PackedBitsArray.h"
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <memory>
+#include <random>
+#include <span>
 #include <stdexcept>
+#include <vector>
+
+/**
+ * Checks that operator[] and decode of both PackedBitsArray and
+ * PackedBitsArrayView agree with the written values, including for the
+ * elements near the end that cannot be read with a 64-bit load.
+ */
+template <uint8_t bits>
+static void testReads() {
+  using utility::PackedBitsArray;
+  using utility::PackedBitsArrayView;
+  static constexpr size_t Size = 301;
+  using Array = PackedBitsArray<bits, Size>;
+  using value_type = typename Array::const_reference;
+
+  std::mt19937_64 engine{bits};
+  std::vector<value_type> values(Size);
+  auto arr = std::make_unique<Array>();
+  for (size_t i = 0; i < Size; ++i) {
+    values[i] = static_cast<value_type>(engine() >> (64 - bits));
+    (*arr)[i] = values[i];
+  }
+
+  const Array& const_arr = *arr;
+  const PackedBitsArrayView<bits, Size> view{arr->rawData().data()};
+  for (size_t i = 0; i < Size; ++i)
+    if (const_arr[i] != values[i] || view[i] != values[i])
+      throw std::logic_error("PackedBitsArray read failed!");
+
+  std::vector<value_type> decoded(Size);
+  for (const size_t& first : {size_t{0}, size_t{1}, size_t{7}, Size - 20}) {
+    for (const size_t& count : {size_t{0}, size_t{1}, size_t{20}}) {
+      const std::span<value_type> output{decoded.data(), count};
+      for (const std::span<value_type> result :
+           {const_arr.decode(first, output), view.decode(first, output)})
+        for (size_t i = 0; i < count; ++i)
+          if (result[i] != values[first + i])
+            throw std::logic_error("PackedBitsArray decode failed!");
+    }
+  }
+  const std::span<value_type> all{decoded.data(), Size};
+  if (!std::equal(values.begin(), values.end(),
+                  const_arr.decode(0, all).begin()))
+    throw std::logic_error("PackedBitsArray decode failed!");
+}
 
 void testPackedBitsArray() {
   using utility::PackedBitsArray;
@@ -17,5 +67,15 @@ void testPackedBitsArray() {
     if (arr[i] != multiplier * i)
       throw std::logic_error("PackedBitsArray failed!");
 
+  testReads<1>();
+  testReads<2>();
+  testReads<3>();
+  testReads<11>();
+  testReads<16>();
+  testReads<25>();
+  testReads<57>();
+  testReads<58>();
+  testReads<64>();
+
   std::cout << "Passed all tests for PackedBitsArray!\n";
 }
@@ -0,0 +1,156 @@
+#include "LookupTableFile.h"
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace utility {
+uint64_t getLookupTableChecksum(const uint8_t* const data, const size_t size) {
+  uint64_t hash = 0xcbf29ce484222325;
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= data[i];
+    hash *= 0x100000001b3;
+  }
+  return hash;
+}
+
+void writeLookupTableFile(const std::string& file_name, const uint8_t bits,
+                          const uint64_t element_count,
+                          const uint64_t table_id, const uint8_t* const data,
+                          const size_t size) {
+  const std::filesystem::path path{file_name};
+  if (path.has_parent_path())
+    std::filesystem::create_directories(path.parent_path());
+
+  const LookupTableHeader header{
+      .magic = LookupTableHeader::Magic,
+      .byte_order_mark = LookupTableHeader::ByteOrderMark,
+      .version = LookupTableHeader::CurrentVersion,
+      .bits = bits,
+      .reserved = 0,
+      .element_count = element_count,
+      .payload_size = size,
+      .checksum = getLookupTableChecksum(data, size),
+      .table_id = table_id};
+
+  // the temporary file is unique to this call, so concurrent writers of the
+  // same table never write to the same file, and renaming it replaces the
+  // table at once
+  static std::atomic<uint64_t> write_count{0};
+  const std::string temporary_file_name =
+      file_name + '.' + std::to_string(::getpid()) + '.' +
+      std::to_string(write_count.fetch_add(1)) + ".tmp";
+  {
+    std::ofstream file{temporary_file_name, std::ios::binary | std::ios::trunc};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(data),
+               static_cast<std::streamsize>(size));
+    file.close();
+    if (!file) {
+      std::filesystem::remove(temporary_file_name);
+      throw std::runtime_error("Could not write " + file_name + "!");
+    }
+  }
+  std::error_code error;
+  std::filesystem::rename(temporary_file_name, file_name, error);
+  if (error) {
+    std::filesystem::remove(temporary_file_name);
+    throw std::runtime_error("Could not write " + file_name + ": " +
+                             error.message());
+  }
+}
+
+MappedLookupTable::MappedLookupTable(void* const mapping,
+                                     const size_t mapping_size)
+    : mapping(mapping), mapping_size(mapping_size) {}
+
+std::optional<MappedLookupTable> MappedLookupTable::open(
+    const std::string& file_name, const uint8_t bits,
+    const uint64_t element_count, const uint64_t table_id) {
+  const int fd = ::open(file_name.c_str(), O_RDONLY);
+  if (fd == -1) {
+    if (errno == ENOENT) return std::nullopt;
+    throw std::runtime_error("Could not open " + file_name + ": " +
+                             std::strerror(errno));
+  }
+
+  struct stat file_stat {};
+  if (::fstat(fd, &file_stat) == -1) {
+    ::close(fd);
+    throw std::runtime_error("Could not stat " + file_name + "!");
+  }
+  const size_t file_size = file_stat.st_size;
+  if (file_size < sizeof(LookupTableHeader)) {
+    ::close(fd);
+    throw std::runtime_error(file_name + " is too small to be a lookup table!");
+  }
+
+  void* const mapping =
+      ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // the mapping remains valid after the file descriptor is closed
+  ::close(fd);
+  if (mapping == MAP_FAILED)
+    throw std::runtime_error("Could not map " + file_name + "!");
+  MappedLookupTable table{mapping, file_size};
+
+  LookupTableHeader header{};
+  std::memcpy(&header, mapping, sizeof(header));
+  if (header.magic != LookupTableHeader::Magic ||
+      header.byte_order_mark != LookupTableHeader::ByteOrderMark)
+    throw std::runtime_error(file_name + " is not a lookup table!");
+  if (header.version != LookupTableHeader::CurrentVersion)
+    throw std::runtime_error(file_name + " has unsupported version " +
+                             std::to_string(header.version) + "!");
+  if (header.bits != bits || header.element_count != element_count)
+    throw std::runtime_error(
+        file_name + " has " + std::to_string(header.element_count) +
+        " elements of " + std::to_string(header.bits) + " bits, expected " +
+        std::to_string(element_count) + " elements of " +
+        std::to_string(bits) + " bits!");
+  if (header.table_id != table_id)
+    throw std::runtime_error(file_name +
+                             " was generated for a different table!");
+  if (header.payload_size != (element_count * bits + 7) / 8 ||
+      header.payload_size != file_size - sizeof(LookupTableHeader))
+    throw std::runtime_error(file_name + " has an invalid payload size!");
+  if (header.checksum != getLookupTableChecksum(table.data(), table.size()))
+    throw std::runtime_error(file_name + " failed its checksum!");
+
+  return table;
+}
+
+MappedLookupTable::MappedLookupTable(MappedLookupTable&& other) noexcept
+    : mapping(std::exchange(other.mapping, nullptr)),
+      mapping_size(std::exchange(other.mapping_size, 0)) {}
+
+MappedLookupTable& MappedLookupTable::operator=(
+    MappedLookupTable&& other) noexcept {
+  if (this != &other) {
+    if (mapping != nullptr) ::munmap(mapping, mapping_size);
+    mapping = std::exchange(other.mapping, nullptr);
+    mapping_size = std::exchange(other.mapping_size, 0);
+  }
+  return *this;
+}
+
+MappedLookupTable::~MappedLookupTable() {
+  if (mapping != nullptr) ::munmap(mapping, mapping_size);
+}
+
+const uint8_t* MappedLookupTable::data() const {
+  return static_cast<const uint8_t*>(mapping) + sizeof(LookupTableHeader);
+}
+
+size_t MappedLookupTable::size() const {
+  return mapping_size - sizeof(LookupTableHeader);
+}
+}  // namespace utility
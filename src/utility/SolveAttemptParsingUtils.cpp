@@ -1,5 +1,7 @@
 #include "SolveAttemptParsingUtils.h"
 #include <fstream>
+#include <istream>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -25,4 +27,21 @@ std::pair<std::string, std::string> loadScrambleSolve(
           contents.substr(scramble_length + 1,
                           contents.size() - scramble_length - 1)};
 }
+
+std::optional<std::pair<std::string, std::string>> readScrambleSolve(
+    std::istream& stream) {
+  std::string line;
+  while (std::getline(stream, line)) {
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    if (line.empty()) continue;
+
+    const size_t separator = line.find('\t');
+    if (separator == std::string::npos)
+      throw std::invalid_argument(
+          "No tab character! Cannot distinguish scramble from solve!");
+    return std::make_pair(line.substr(0, separator),
+                          line.substr(separator + 1));
+  }
+  return std::nullopt;
+}
 }  // namespace utility
\ No newline at end of file